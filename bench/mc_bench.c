@@ -0,0 +1,734 @@
+#include "../include/CGLM/cglm.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#include "../src/headers/chunk.h"
+#include "../src/headers/blocks.h"
+#include "../src/headers/mesh_builder.h"
+#include "../src/headers/mesher.h"
+#include "../src/headers/terrain.h"
+#include "../src/headers/raycast.h"
+#include "../src/headers/world_random.h"
+#include "../src/headers/culling.h"
+#include "../src/headers/occlusion.h"
+
+#include "../include/NOISE/noise1234.h"
+
+// headless benchmark of the hot paths of the game (terrain generation, meshing with each of the meshers, chunk seams, culling
+// and the pointer raycast), needs no window or opengl, and writes its results out as json so runs can be compared across commits
+
+
+// ---
+
+
+// settings
+
+// seed used for everything random (noise offset, trees, random chunks and rays), so runs are comparable
+const unsigned int BENCH_SEED = 1337;
+
+// amount of chunks generated for the generation benchmark
+const int GENERATE_CHUNKS = 256;
+
+// amount of times every chunk gets meshed per mesher
+const int MESH_ITERATIONS = 200;
+
+// amount of rays cast per world
+const int RAY_COUNT = 200000;
+
+// amount of times the occlusion buffer gets drawn (and every chunk tested against it) per world
+const int OCCLUSION_ITERATIONS = 2000;
+
+// amount of points the noise gets sampled at, and how far the batched noise may be off from noise2
+const int NOISE_SAMPLES = 1 << 20;
+const float NOISE_TOLERANCE = 1e-6f;
+
+// file the results are written to, unless another one is given as the first argument
+const char* DEFAULT_RESULTS_PATH = "mc_bench.json";
+
+
+// ---
+
+
+// the kinds of worlds that get benchmarked
+enum BenchWorld {
+	BENCH_TERRAIN,     // the game's own terrain generation (with trees)
+	BENCH_RANDOM,      // random mix of air, water and solid blocks
+	BENCH_CHECKERBOARD // every other block solid, the worst case for face counts
+};
+
+const char* BENCH_WORLD_NAMES[] = { "terrain", "random", "checkerboard" };
+
+// a mesher that can be benchmarked
+typedef void (*BenchMesher)(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, struct MeshBuilder* builder);
+
+// size of the grid of chunks a world is made of (the middle chunk has all of its surrounding chunks)
+#define BENCH_GRID 3
+
+// chunks of the current world, indexed by z*BENCH_GRID + x
+struct Chunk benchChunks[BENCH_GRID*BENCH_GRID];
+
+
+// ---
+
+
+// a single benchmark result
+struct BenchResult {
+	const char* benchmark; // what was measured
+	const char* world; // the world it was measured on
+	const char* unit; // what was counted
+
+	int iterations; // amount of times it was run
+	double seconds; // total time taken
+	long count; // total amount of units counted
+};
+
+// most results that get kept
+#define MAX_BENCH_RESULTS 64
+
+// results so far
+struct BenchResult benchResults[MAX_BENCH_RESULTS];
+int benchResultCount = 0;
+
+
+// ---
+
+
+// current time in seconds
+double bench_time() {
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
+
+// records a result and prints it out
+void add_bench_result(const char* benchmark, const char* world, const char* unit, int iterations, double seconds, long count) {
+	if(benchResultCount < MAX_BENCH_RESULTS) {
+		benchResults[benchResultCount++] = (struct BenchResult){ benchmark, world, unit, iterations, seconds, count };
+	}
+
+	printf("  %-16s %-13s %10ld %-7s %10.3f ms  %14.0f %s/s\n",
+		benchmark, world, count, unit, seconds * 1e3, (double)count / seconds, unit);
+}
+
+// writes out all the results as json, returns false if the file couldn't be written
+bool write_bench_results(const char* path) {
+	FILE* file = fopen(path, "w");
+
+	if(file == NULL) {
+		return false;
+	}
+
+	fprintf(file, "{\n");
+	fprintf(file, "  \"seed\": %u,\n", BENCH_SEED);
+	fprintf(file, "  \"chunk_size\": [%d, %d, %d],\n", CHUNK_WIDTH, CHUNK_HEIGHT, CHUNK_LENGTH);
+	fprintf(file, "  \"results\": [\n");
+
+	for(int i = 0; i < benchResultCount; i++) {
+		struct BenchResult result = benchResults[i];
+
+		fprintf(file, "    { \"benchmark\": \"%s\", \"world\": \"%s\", \"unit\": \"%s\", \"iterations\": %d, \"seconds\": %.9f, \"count\": %ld, \"per_second\": %.3f }%s\n",
+			result.benchmark, result.world, result.unit, result.iterations, result.seconds, result.count,
+			(double)result.count / result.seconds,
+			i < benchResultCount-1 ? "," : "");
+	}
+
+	fprintf(file, "  ]\n");
+	fprintf(file, "}\n");
+
+	fclose(file);
+
+	return true;
+}
+
+
+// ---
+
+
+// fills the blocks of a chunk with the given kind of world
+void fill_bench_chunk(struct Chunk* chunk, enum BenchWorld world) {
+
+	if(world == BENCH_TERRAIN) {
+		generate_chunk_blocks(chunk);
+		return;
+	}
+
+	int8_t blockTypes[CHUNK_VOLUME];
+
+	for(int y = 0; y < CHUNK_HEIGHT; y++) {
+		for(int z = 0; z < CHUNK_LENGTH; z++) {
+			for(int x = 0; x < CHUNK_WIDTH; x++) {
+
+				int type;
+
+				if(world == BENCH_RANDOM) {
+					type = (rand() % 4) - 1;
+				}
+				else {
+					type = (x + y + z) % 2 == 0 ? 3 : 0;
+				}
+
+				blockTypes[get_block_index(x, y, z)] = type;
+
+			}
+		}
+	}
+
+	pack_chunk_blocks(chunk, blockTypes);
+
+}
+
+// fills the whole grid of chunks with the given kind of world
+void fill_bench_world(enum BenchWorld world) {
+	srand(BENCH_SEED);
+
+	for(int i = 0; i < BENCH_GRID*BENCH_GRID; i++) {
+		fill_bench_chunk(&benchChunks[i], world);
+	}
+}
+
+// looks up a chunk of the grid for the raycast
+struct Chunk* get_bench_chunk(int xPos, int yPos) {
+	if(xPos < 0 || xPos >= BENCH_GRID || yPos < 0 || yPos >= BENCH_GRID) {
+		return NULL;
+	}
+
+	return &benchChunks[yPos*BENCH_GRID + xPos];
+}
+
+
+// ---
+
+
+// samples the noise at random points one at a time and in a batch, and checks that the batch came out the same
+bool bench_noise() {
+
+	float* xs = malloc(sizeof(float) * NOISE_SAMPLES);
+	float* ys = malloc(sizeof(float) * NOISE_SAMPLES);
+	float* single = malloc(sizeof(float) * NOISE_SAMPLES);
+	float* batch = malloc(sizeof(float) * NOISE_SAMPLES);
+
+	srand(BENCH_SEED);
+
+	for(int i = 0; i < NOISE_SAMPLES; i++) {
+		xs[i] = ((float)rand() / RAND_MAX - 0.5f) * 2000;
+		ys[i] = ((float)rand() / RAND_MAX - 0.5f) * 2000;
+
+		// whole numbers are a special case of the floor noise2 uses, so make sure there are some
+		if(i % 8 == 0) {
+			xs[i] = floorf(xs[i]);
+		}
+	}
+
+	double start = bench_time();
+
+	for(int i = 0; i < NOISE_SAMPLES; i++) {
+		single[i] = noise2(xs[i], ys[i]);
+	}
+
+	double elapsed = bench_time() - start;
+
+	add_bench_result("noise2", "points", "samples", NOISE_SAMPLES, elapsed, NOISE_SAMPLES);
+
+	start = bench_time();
+
+	noise2_batch(xs, ys, batch, NOISE_SAMPLES);
+
+	elapsed = bench_time() - start;
+
+	add_bench_result("noise2_batch", "points", "samples", NOISE_SAMPLES, elapsed, NOISE_SAMPLES);
+
+	float maxDifference = 0.0f;
+
+	for(int i = 0; i < NOISE_SAMPLES; i++) {
+		maxDifference = glm_max(maxDifference, fabsf(batch[i] - single[i]));
+	}
+
+	printf("  (batched noise is off by at most %g)\n", maxDifference);
+
+	free(xs);
+	free(ys);
+	free(single);
+	free(batch);
+
+	if(maxDifference > NOISE_TOLERANCE) {
+		printf("  batched noise differs from noise2 by %g, more than %g\n", maxDifference, NOISE_TOLERANCE);
+		return false;
+	}
+
+	return true;
+
+}
+
+// generates chunks of terrain and trees one after another, then checks that generating one again gives the same blocks
+bool bench_generation() {
+
+	struct Chunk chunk;
+	init_chunk_blocks(&chunk, 0);
+
+	// amount of blocks that ended up as logs (trees come from the world seed, so this shows the same trees got placed)
+	long logs = 0;
+
+	double start = bench_time();
+
+	for(int i = 0; i < GENERATE_CHUNKS; i++) {
+		glm_vec2_copy( (vec2){ i % 16, i / 16 }, chunk.pos );
+
+		generate_chunk_blocks(&chunk);
+
+		for(int section = 0; section < CHUNK_SECTIONS; section++) {
+			if(get_section_type(&chunk, section) == 0) {
+				continue;
+			}
+
+			for(int b = 0; b < SECTION_VOLUME; b++) {
+				logs += get_storage_block(&chunk.sections[section], b) == 5;
+			}
+		}
+	}
+
+	double elapsed = bench_time() - start;
+
+	add_bench_result("generate", "terrain", "chunks", GENERATE_CHUNKS, elapsed, GENERATE_CHUNKS);
+
+	printf("  (%ld log blocks placed)\n", logs);
+
+	// the first chunk again, now that every other chunk has been generated since
+	struct Chunk again;
+	init_chunk_blocks(&again, 0);
+
+	glm_vec2_copy( (vec2){ 0, 0 }, chunk.pos );
+	glm_vec2_copy( (vec2){ 0, 0 }, again.pos );
+
+	generate_chunk_blocks(&again);
+	generate_chunk_blocks(&chunk);
+
+	int differences = 0;
+
+	for(int y = 0; y < CHUNK_HEIGHT; y++) {
+		for(int z = 0; z < CHUNK_LENGTH; z++) {
+			for(int x = 0; x < CHUNK_WIDTH; x++) {
+				differences += get_block_type(&chunk, x, y, z) != get_block_type(&again, x, y, z);
+			}
+		}
+	}
+
+	free_chunk_blocks(&chunk);
+	free_chunk_blocks(&again);
+
+	if(differences > 0) {
+		printf("  generating the same chunk twice gave %d different blocks\n", differences);
+		return false;
+	}
+
+	return true;
+
+}
+
+// meshes the middle chunk of the current world with the default (binary), greedy and naive meshers, and the default one into
+// face records (for vertex pulling), checking that the naive mesher came up with the same amount of faces as the binary one
+bool bench_meshing(enum BenchWorld world, struct MeshBuilder* builder) {
+
+	struct Chunk* chunk = get_bench_chunk(1, 1);
+
+	// amount of sections that are all a single type
+	int uniformSections = 0;
+
+	for(int i = 0; i < CHUNK_SECTIONS; i++) {
+		uniformSections += get_section_type(chunk, i) != SECTION_MIXED;
+	}
+
+	// memory held by the palette compressed blocks of the chunk, against 4 bytes per block
+	printf("  (%d bytes of blocks, %d of %d sections uniform, %.1fx smaller than an int array)\n",
+		get_chunk_blocks_size(chunk), uniformSections, CHUNK_SECTIONS,
+		(double)(sizeof(int) * CHUNK_VOLUME) / get_chunk_blocks_size(chunk));
+
+	const char* names[] = { "mesh", "mesh_greedy", "mesh_naive", "mesh_records" };
+
+	BenchMesher meshers[] = { build_chunk_mesh_binary, build_chunk_mesh_greedy, build_chunk_mesh_naive, build_chunk_mesh_binary };
+
+	// faces of the binary mesher, which the naive one has to match exactly
+	int binaryFaces = 0;
+	int naiveFaces = 0;
+
+	for(int mesher = 0; mesher < 4; mesher++) {
+
+		(*builder).faceRecords = mesher == 3;
+
+		double start = bench_time();
+
+		for(int i = 0; i < MESH_ITERATIONS; i++) {
+			meshers[mesher](chunk, get_bench_chunk(0, 1), get_bench_chunk(2, 1), get_bench_chunk(1, 2), get_bench_chunk(1, 0), builder);
+		}
+
+		double elapsed = bench_time() - start;
+
+		int faces = (*builder).indexCount / 6;
+
+		if(mesher == 0) {
+			binaryFaces = faces;
+		}
+		else if(mesher == 2) {
+			naiveFaces = faces;
+		}
+
+		add_bench_result(names[mesher], BENCH_WORLD_NAMES[world], "faces", MESH_ITERATIONS, elapsed, (long)faces * MESH_ITERATIONS);
+
+	}
+
+	(*builder).faceRecords = false;
+
+	if(naiveFaces != binaryFaces) {
+		printf("  naive mesher produced %d faces, the binary one %d\n", naiveFaces, binaryFaces);
+		return false;
+	}
+
+	return true;
+
+}
+
+// meshes the middle chunk of the current world against its surrounding chunks, and against the edge of the world,
+// the difference is what the seams between chunks cost
+bool bench_seams(enum BenchWorld world, struct MeshBuilder* builder) {
+
+	struct Chunk* chunk = get_bench_chunk(1, 1);
+
+	// faces with and without the surrounding chunks
+	int faces[2];
+
+	for(int edge = 0; edge < 2; edge++) {
+
+		double start = bench_time();
+
+		for(int i = 0; i < MESH_ITERATIONS; i++) {
+			if(edge) {
+				build_chunk_mesh_binary(chunk, NULL, NULL, NULL, NULL, builder);
+			}
+			else {
+				build_chunk_mesh_binary(chunk, get_bench_chunk(0, 1), get_bench_chunk(2, 1), get_bench_chunk(1, 2), get_bench_chunk(1, 0), builder);
+			}
+		}
+
+		double elapsed = bench_time() - start;
+
+		faces[edge] = (*builder).indexCount / 6;
+
+		add_bench_result(edge ? "seams_edge" : "seams_neighbours", BENCH_WORLD_NAMES[world], "chunks", MESH_ITERATIONS, elapsed, MESH_ITERATIONS);
+
+	}
+
+	// the naive mesher checks every side on its own, so it has to agree on the faces along the seams
+	build_chunk_mesh_naive(chunk, get_bench_chunk(0, 1), get_bench_chunk(2, 1), get_bench_chunk(1, 2), get_bench_chunk(1, 0), builder);
+
+	int naiveFaces = (*builder).indexCount / 6;
+
+	// the edge of the world is air, so the surrounding chunks can only hide faces along the seams
+	printf("  (%d faces along the seams hidden by the surrounding chunks)\n", faces[1] - faces[0]);
+
+	if(naiveFaces != faces[0]) {
+		printf("  binary mesher produced %d faces against the surrounding chunks, expected %d\n", faces[0], naiveFaces);
+		return false;
+	}
+
+	return true;
+
+}
+
+// rebuilds a single section of the middle chunk of the current world (what a block edit costs), the sections built one at
+// a time have to add up to the faces of the whole chunk
+bool bench_sections(enum BenchWorld world, struct MeshBuilder* builder) {
+
+	struct Chunk* chunk = get_bench_chunk(1, 1);
+
+	double start = bench_time();
+
+	for(int i = 0; i < MESH_ITERATIONS; i++) {
+		build_chunk_sections(chunk, get_bench_chunk(0, 1), get_bench_chunk(2, 1), get_bench_chunk(1, 2), get_bench_chunk(1, 0),
+			CHUNK_SECTIONS/2, CHUNK_SECTIONS/2, builder);
+	}
+
+	double elapsed = bench_time() - start;
+
+	add_bench_result("remesh_section", BENCH_WORLD_NAMES[world], "sections", MESH_ITERATIONS, elapsed, MESH_ITERATIONS);
+
+	// faces of every section on its own
+	int sectionFaces = 0;
+
+	for(int section = 0; section < CHUNK_SECTIONS; section++) {
+		build_chunk_sections(chunk, get_bench_chunk(0, 1), get_bench_chunk(2, 1), get_bench_chunk(1, 2), get_bench_chunk(1, 0),
+			section, section, builder);
+
+		sectionFaces += (*builder).indexCount / 6;
+	}
+
+	build_chunk_mesh(chunk, get_bench_chunk(0, 1), get_bench_chunk(2, 1), get_bench_chunk(1, 2), get_bench_chunk(1, 0), builder);
+
+	int chunkFaces = (*builder).indexCount / 6;
+
+	if(sectionFaces != chunkFaces) {
+		printf("  sections built one at a time produced %d faces, the whole chunk %d\n", sectionFaces, chunkFaces);
+		return false;
+	}
+
+	return true;
+
+}
+
+// works out which faces of every chunk of the current world are connected (what cave culling runs on, redone after every edit)
+void bench_face_connections(enum BenchWorld world) {
+
+	// amount of face pairs that ended up connected
+	int connected = 0;
+
+	double start = bench_time();
+
+	for(int i = 0; i < MESH_ITERATIONS; i++) {
+		for(int c = 0; c < BENCH_GRID*BENCH_GRID; c++) {
+			benchChunks[c].faceConnections = calc_chunk_face_connections(&benchChunks[c]);
+		}
+	}
+
+	double elapsed = bench_time() - start;
+
+	for(int c = 0; c < BENCH_GRID*BENCH_GRID; c++) {
+		for(int bit = 0; bit < 15; bit++) {
+			connected += (benchChunks[c].faceConnections >> bit) & 1;
+		}
+	}
+
+	add_bench_result("face_connections", BENCH_WORLD_NAMES[world], "chunks", MESH_ITERATIONS, elapsed, (long)MESH_ITERATIONS * BENCH_GRID*BENCH_GRID);
+
+	printf("  (%d of %d face pairs connected)\n", connected, 15 * BENCH_GRID*BENCH_GRID);
+
+}
+
+// draws the occluders of every chunk of the current world into an occlusion buffer, along with a solid wall chunk in front of
+// the middle row of them, and tests every chunk against it (what occlusion culling does every frame), checking that the chunks
+// behind the wall ended up hidden and the wall itself didn't
+bool bench_occlusion(enum BenchWorld world) {
+
+	// the chunks of the world, then the wall
+	struct OccluderChunk occluderChunks[BENCH_GRID*BENCH_GRID + 1];
+
+	double start = bench_time();
+
+	for(int i = 0; i < MESH_ITERATIONS; i++) {
+		for(int c = 0; c < BENCH_GRID*BENCH_GRID; c++) {
+			calc_chunk_occluders(&benchChunks[c], &benchChunks[c].occluders);
+		}
+	}
+
+	double elapsed = bench_time() - start;
+
+	add_bench_result("occluders", BENCH_WORLD_NAMES[world], "chunks", MESH_ITERATIONS, elapsed, (long)MESH_ITERATIONS * BENCH_GRID*BENCH_GRID);
+
+	for(int c = 0; c < BENCH_GRID*BENCH_GRID; c++) {
+		occluderChunks[c] = (struct OccluderChunk){ benchChunks[c].pos[0], benchChunks[c].pos[1], benchChunks[c].occluders };
+	}
+
+	// a completely solid chunk right before the middle row, which hides the whole row from a camera just in front of it
+	struct Chunk wall;
+	init_chunk_blocks(&wall, 3);
+
+	struct OccluderChunk* wallChunk = &occluderChunks[BENCH_GRID*BENCH_GRID];
+
+	(*wallChunk).x = -1;
+	(*wallChunk).z = 1;
+	calc_chunk_occluders(&wall, &(*wallChunk).occluders);
+
+	free_chunk_blocks(&wall);
+
+	// standing halfway up the wall in the middle of the chunk before it, looking along the row
+	vec3 camPos = { -CHUNK_WIDTH*1.5f, CHUNK_HEIGHT/2, CHUNK_LENGTH*1.5f };
+
+	mat4 proj, view, viewProj;
+	glm_perspective(glm_rad(70.0f), 16.0f/9.0f, 0.1f, 1000.0f, proj);
+	glm_look(camPos, (vec3){ 1, 0, 0 }, (vec3){ 0, 1, 0 }, view);
+	glm_mat4_mul(proj, view, viewProj);
+
+	struct OcclusionBuffer buffer;
+	init_occlusion_buffer(&buffer);
+
+	// amount of chunks that ended up hidden, and whether or not the middle row was one of them
+	int occluded = 0;
+	bool rowOccluded = true;
+
+	start = bench_time();
+
+	for(int i = 0; i < OCCLUSION_ITERATIONS; i++) {
+		draw_occlusion_buffer(&buffer, viewProj, camPos, occluderChunks, BENCH_GRID*BENCH_GRID + 1);
+
+		occluded = 0;
+		rowOccluded = true;
+
+		for(int c = 0; c < BENCH_GRID*BENCH_GRID; c++) {
+			vec3 boxMin = { benchChunks[c].pos[0]*CHUNK_WIDTH, 0, benchChunks[c].pos[1]*CHUNK_LENGTH };
+			vec3 boxMax = { boxMin[0] + CHUNK_WIDTH, benchChunks[c].occluders.topHeight, boxMin[2] + CHUNK_LENGTH };
+
+			bool hidden = is_box_occluded(&buffer, boxMin, boxMax);
+
+			occluded += hidden;
+
+			if(benchChunks[c].pos[1] == 1 && !hidden) {
+				rowOccluded = false;
+			}
+		}
+	}
+
+	elapsed = bench_time() - start;
+
+	// the wall is right in front of the camera, so it can't be hiding itself
+	vec3 wallMin = { -CHUNK_WIDTH, 0, CHUNK_LENGTH };
+	vec3 wallMax = { 0, CHUNK_HEIGHT, CHUNK_LENGTH*2 };
+
+	bool wallOccluded = is_box_occluded(&buffer, wallMin, wallMax);
+
+	free_occlusion_buffer(&buffer);
+
+	add_bench_result("occlusion_buffer", BENCH_WORLD_NAMES[world], "frames", OCCLUSION_ITERATIONS, elapsed, OCCLUSION_ITERATIONS);
+
+	printf("  (%d of %d chunks occluded)\n", occluded, BENCH_GRID*BENCH_GRID);
+
+	if(!rowOccluded) {
+		printf("  chunks behind the wall weren't occluded\n");
+		return false;
+	}
+
+	if(wallOccluded) {
+		printf("  the wall in front of the camera was occluded\n");
+		return false;
+	}
+
+	return true;
+
+}
+
+// casts rays in random directions from random spots above the middle chunk of the current world
+void bench_raycast(enum BenchWorld world) {
+
+	// the rays are made up front, so only the casting is timed
+	vec3* origins = malloc(sizeof(vec3) * RAY_COUNT);
+	vec3* fronts = malloc(sizeof(vec3) * RAY_COUNT);
+
+	srand(BENCH_SEED);
+
+	for(int i = 0; i < RAY_COUNT; i++) {
+		origins[i][0] = CHUNK_WIDTH  + (float)rand() / RAND_MAX * CHUNK_WIDTH;
+		origins[i][1] = CHUNK_HEIGHT/2 + (float)rand() / RAND_MAX * CHUNK_HEIGHT/2;
+		origins[i][2] = CHUNK_LENGTH + (float)rand() / RAND_MAX * CHUNK_LENGTH;
+
+		fronts[i][0] = (float)rand() / RAND_MAX * 2 - 1;
+		fronts[i][1] = (float)rand() / RAND_MAX * 2 - 1;
+		fronts[i][2] = (float)rand() / RAND_MAX * 2 - 1;
+
+		glm_vec3_normalize(fronts[i]);
+	}
+
+	vec3 hitPos;
+	vec3 lastPos = GLM_VEC3_ZERO_INIT;
+
+	long hits = 0;
+
+	double start = bench_time();
+
+	for(int i = 0; i < RAY_COUNT; i++) {
+		hits += cast_pointer_ray(get_bench_chunk, origins[i], fronts[i], hitPos, lastPos) != 0;
+	}
+
+	double elapsed = bench_time() - start;
+
+	add_bench_result("raycast", BENCH_WORLD_NAMES[world], "rays", RAY_COUNT, elapsed, RAY_COUNT);
+
+	printf("  (%ld of %d rays hit a block)\n", hits, RAY_COUNT);
+
+	free(origins);
+	free(fronts);
+
+}
+
+
+// ---
+
+
+int main(int argc, char** argv) {
+
+	const char* resultsPath = argc > 1 ? argv[1] : DEFAULT_RESULTS_PATH;
+
+	// the terrain (noise offset and trees) comes from the world seed
+	set_world_seed(BENCH_SEED);
+
+	struct MeshBuilder builder;
+	init_mesh_builder(&builder);
+
+	for(int i = 0; i < BENCH_GRID*BENCH_GRID; i++) {
+		init_chunk_blocks(&benchChunks[i], 0);
+		glm_vec2_copy( (vec2){ i % BENCH_GRID, i / BENCH_GRID }, benchChunks[i].pos );
+	}
+
+	// whether or not all the meshers (and the noise functions, and repeated generation) agreed with each other, and the
+	// occlusion culling hid what it should have
+	bool failed = false;
+
+	printf("noise:\n");
+
+	if(!bench_noise()) {
+		failed = true;
+	}
+
+	printf("generation:\n");
+	if(!bench_generation()) {
+		failed = true;
+	}
+
+	for(int world = BENCH_TERRAIN; world <= BENCH_CHECKERBOARD; world++) {
+
+		printf("%s:\n", BENCH_WORLD_NAMES[world]);
+
+		fill_bench_world(world);
+
+		if(!bench_meshing(world, &builder)) {
+			failed = true;
+		}
+
+		if(!bench_seams(world, &builder)) {
+			failed = true;
+		}
+
+		if(!bench_sections(world, &builder)) {
+			failed = true;
+		}
+
+		bench_face_connections(world);
+
+		if(!bench_occlusion(world)) {
+			failed = true;
+		}
+
+		bench_raycast(world);
+
+	}
+
+	for(int i = 0; i < BENCH_GRID*BENCH_GRID; i++) {
+		free_chunk_blocks(&benchChunks[i]);
+	}
+
+	free_mesh_builder(&builder);
+
+
+	// ---
+
+
+	if(!write_bench_results(resultsPath)) {
+		printf("couldn't write results to %s\n", resultsPath);
+		return 1;
+	}
+
+	printf("results written to %s\n", resultsPath);
+
+	return failed ? 1 : 0;
+
+}
@@ -32,6 +32,11 @@ extern float noise2( float x, float y );
 extern float noise3( float x, float y, float z );
 extern float noise4( float x, float y, float z, float w );
 
+/** 2D float Perlin noise of n points at once, out[i] = noise2( xs[i], ys[i] )
+ * (SIMD when the target supports AVX2, SSE2 or NEON)
+ */
+extern void noise2_batch( const float* xs, const float* ys, float* out, int n );
+
 /** 1D, 2D, 3D and 4D float Perlin periodic noise
  */
 extern float pnoise1( float x, int px );
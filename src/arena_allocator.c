@@ -0,0 +1,195 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "headers/arena_allocator.h"
+
+// sub-allocates ranges out of an arena with a free list, doesn't touch opengl (or the memory being handed out)
+
+
+// ---
+
+
+// amount of free ranges the list is sized for upon the first allocation
+const int ARENA_INITIAL_RANGES = 64;
+
+
+// ---
+
+
+// inserts a free range into the list at an index, growing the list if necessary
+void insert_free_range(struct ArenaAllocator* allocator, int index, struct ArenaRange range) {
+
+	// start off with the initial size, otherwise double it
+	if((*allocator).freeCount == (*allocator).freeCapacity) {
+		int newCapacity = (*allocator).freeCapacity == 0 ? ARENA_INITIAL_RANGES : (*allocator).freeCapacity * 2;
+
+		(*allocator).freeRanges = realloc((*allocator).freeRanges, sizeof(struct ArenaRange) * newCapacity);
+		(*allocator).freeCapacity = newCapacity;
+	}
+
+	memmove(&(*allocator).freeRanges[index+1], &(*allocator).freeRanges[index], sizeof(struct ArenaRange) * ((*allocator).freeCount - index));
+
+	(*allocator).freeRanges[index] = range;
+	(*allocator).freeCount++;
+
+}
+
+// removes the free range at an index from the list
+void remove_free_range(struct ArenaAllocator* allocator, int index) {
+	memmove(&(*allocator).freeRanges[index], &(*allocator).freeRanges[index+1], sizeof(struct ArenaRange) * ((*allocator).freeCount - index-1));
+
+	(*allocator).freeCount--;
+}
+
+
+// ---
+
+
+// initiates an allocator with the whole arena free
+void init_arena_allocator(struct ArenaAllocator* allocator, int capacity) {
+	(*allocator).freeRanges = NULL;
+	(*allocator).freeCount = 0;
+	(*allocator).freeCapacity = 0;
+
+	(*allocator).capacity = capacity;
+	(*allocator).used = 0;
+
+	if(capacity > 0) {
+		insert_free_range(allocator, 0, (struct ArenaRange){ 0, capacity });
+	}
+}
+
+// frees up the whole arena
+void reset_arena_allocator(struct ArenaAllocator* allocator) {
+	(*allocator).freeCount = 0;
+	(*allocator).used = 0;
+
+	if((*allocator).capacity > 0) {
+		insert_free_range(allocator, 0, (struct ArenaRange){ 0, (*allocator).capacity });
+	}
+}
+
+
+// ---
+
+
+// hands out size units of the arena out of the smallest free range they fit in (which keeps the big ones around for big meshes)
+int arena_allocate(struct ArenaAllocator* allocator, int size) {
+
+	int best = -1;
+
+	for(int i = 0; i < (*allocator).freeCount; i++) {
+		int rangeSize = (*allocator).freeRanges[i].size;
+
+		if(rangeSize >= size && (best == -1 || rangeSize < (*allocator).freeRanges[best].size)) {
+			best = i;
+
+			// can't do better than an exact fit
+			if(rangeSize == size) {
+				break;
+			}
+		}
+	}
+
+	if(best == -1) {
+		return -1;
+	}
+
+	// take it off the front of the range
+	int start = (*allocator).freeRanges[best].start;
+
+	(*allocator).freeRanges[best].start += size;
+	(*allocator).freeRanges[best].size -= size;
+
+	if((*allocator).freeRanges[best].size == 0) {
+		remove_free_range(allocator, best);
+	}
+
+	(*allocator).used += size;
+
+	return start;
+
+}
+
+// gives a range back to the arena, merging it with the free ranges right before and after it
+void arena_release(struct ArenaAllocator* allocator, int start, int size) {
+
+	if(size <= 0) {
+		return;
+	}
+
+	(*allocator).used -= size;
+
+	// the first free range after it
+	int next = 0;
+
+	while(next < (*allocator).freeCount && (*allocator).freeRanges[next].start < start) {
+		next++;
+	}
+
+	bool joinsPrevious = next > 0
+		&& (*allocator).freeRanges[next-1].start + (*allocator).freeRanges[next-1].size == start;
+	bool joinsNext = next < (*allocator).freeCount
+		&& start + size == (*allocator).freeRanges[next].start;
+
+	if(joinsPrevious && joinsNext) {
+		(*allocator).freeRanges[next-1].size += size + (*allocator).freeRanges[next].size;
+
+		remove_free_range(allocator, next);
+	}
+	else if(joinsPrevious) {
+		(*allocator).freeRanges[next-1].size += size;
+	}
+	else if(joinsNext) {
+		(*allocator).freeRanges[next].start = start;
+		(*allocator).freeRanges[next].size += size;
+	}
+	else {
+		insert_free_range(allocator, next, (struct ArenaRange){ start, size });
+	}
+
+}
+
+
+// ---
+
+
+// makes the arena bigger, the new space is added onto the end
+void grow_arena_allocator(struct ArenaAllocator* allocator, int capacity) {
+	if(capacity <= (*allocator).capacity) {
+		return;
+	}
+
+	int oldCapacity = (*allocator).capacity;
+
+	(*allocator).capacity = capacity;
+
+	// released as if it had been handed out, so it merges with a free range at the end
+	(*allocator).used += capacity - oldCapacity;
+
+	arena_release(allocator, oldCapacity, capacity - oldCapacity);
+}
+
+// getter for the size of the biggest free range
+int get_arena_largest_free(struct ArenaAllocator* allocator) {
+	int largest = 0;
+
+	for(int i = 0; i < (*allocator).freeCount; i++) {
+		if((*allocator).freeRanges[i].size > largest) {
+			largest = (*allocator).freeRanges[i].size;
+		}
+	}
+
+	return largest;
+}
+
+
+// ---
+
+
+// frees the memory held by an allocator
+void free_arena_allocator(struct ArenaAllocator* allocator) {
+	free((*allocator).freeRanges);
+
+	init_arena_allocator(allocator, 0);
+}
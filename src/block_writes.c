@@ -0,0 +1,135 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "headers/chunk.h"
+#include "headers/blocks.h"
+#include "headers/block_writes.h"
+
+// lists of blocks that have to be placed in chunks other than the one that made them (like the leaves of trees on chunk borders)
+
+
+// ---
+
+
+// settings
+
+// amount of writes a list is sized for upon the first allocation
+const int BLOCK_WRITES_INITIAL_SIZE = 64;
+
+
+// ---
+
+
+// initiates an empty list of block writes
+void init_block_writes(struct BlockWrites* list) {
+	(*list).writes = NULL;
+	(*list).count = 0;
+	(*list).capacity = 0;
+}
+
+// appends a block write to a list, doubling its size whenever it runs out of space
+void add_block_write(struct BlockWrites* list, struct BlockWrite write) {
+	if((*list).count >= (*list).capacity) {
+
+		// start off with the initial size, otherwise double it
+		int newCapacity = (*list).capacity == 0 ? BLOCK_WRITES_INITIAL_SIZE : (*list).capacity * 2;
+
+		(*list).writes = realloc((*list).writes, sizeof(struct BlockWrite) * newCapacity);
+		(*list).capacity = newCapacity;
+
+	}
+
+	(*list).writes[(*list).count++] = write;
+}
+
+
+// ---
+
+
+// appends every write of a list that goes into the chunk at chunkX, chunkZ to another list
+void copy_block_writes_into(struct BlockWrites* list, int chunkX, int chunkZ, struct BlockWrites* destination) {
+	for(int i = 0; i < (*list).count; i++) {
+		if((*list).writes[i].chunkX == chunkX && (*list).writes[i].chunkZ == chunkZ) {
+			add_block_write(destination, (*list).writes[i]);
+		}
+	}
+}
+
+// removes every write made by the chunk at sourceX, sourceZ from a list (the order of the rest is kept)
+void remove_block_writes_from(struct BlockWrites* list, int sourceX, int sourceZ) {
+	int kept = 0;
+
+	for(int i = 0; i < (*list).count; i++) {
+		if((*list).writes[i].sourceX != sourceX || (*list).writes[i].sourceZ != sourceZ) {
+			(*list).writes[kept++] = (*list).writes[i];
+		}
+	}
+
+	(*list).count = kept;
+}
+
+
+// ---
+
+
+// places the writes of a list that go into a chunk (only into air) in an unpacked array of its blocks
+bool apply_block_writes(struct BlockWrites* list, int chunkX, int chunkZ, int8_t* blockTypes) {
+	bool changed = false;
+
+	for(int i = 0; i < (*list).count; i++) {
+		struct BlockWrite* write = &(*list).writes[i];
+
+		if((*write).chunkX != chunkX || (*write).chunkZ != chunkZ) {
+			continue;
+		}
+
+		int index = get_block_index((*write).x, (*write).y, (*write).z);
+
+		if(blockTypes[index] == 0) {
+			blockTypes[index] = (*write).type;
+			changed = true;
+		}
+	}
+
+	return changed;
+}
+
+// places the writes of a list that go into a chunk (only into air) in its packed blocks
+bool apply_block_writes_to_chunk(struct BlockWrites* list, struct Chunk* chunk) {
+	bool changed = false;
+
+	int chunkX = (*chunk).pos[0];
+	int chunkZ = (*chunk).pos[1];
+
+	for(int i = 0; i < (*list).count; i++) {
+		struct BlockWrite* write = &(*list).writes[i];
+
+		if((*write).chunkX != chunkX || (*write).chunkZ != chunkZ) {
+			continue;
+		}
+
+		if(get_block_type(chunk, (*write).x, (*write).y, (*write).z) == 0) {
+			set_block_type(chunk, (*write).x, (*write).y, (*write).z, (*write).type);
+			changed = true;
+		}
+	}
+
+	return changed;
+}
+
+
+// ---
+
+
+// empties a list while keeping its memory
+void clear_block_writes(struct BlockWrites* list) {
+	(*list).count = 0;
+}
+
+// frees the memory held by a list of block writes
+void free_block_writes(struct BlockWrites* list) {
+	free((*list).writes);
+
+	init_block_writes(list);
+}
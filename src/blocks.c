@@ -0,0 +1,425 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "headers/chunk.h"
+#include "headers/blocks.h"
+
+
+// ---
+
+
+// block registry, indexed by type - MIN_BLOCK_TYPE (so water, which is -1, comes first)
+const struct BlockInfo BLOCK_REGISTRY[] = {
+	// water
+	{
+		.name = "water", .solid = false, .faces = ALL_FACES & ~FACE_BIT(FACE_BOTTOM), .renderLayers = RENDER_LAYER_TRANSLUCENT, .yOff = 0.2f,
+		//          front      back       left       right      bottom     top
+		.tiles = { {15, 14}, {15, 14}, {15, 14}, {15, 14}, {15, 14}, {7, 0} },
+	},
+	// air
+	{
+		.name = "air", .solid = false, .faces = 0,
+	},
+	// grass
+	{
+		.name = "grass", .solid = true, .faces = ALL_FACES, .renderLayers = RENDER_LAYER_OPAQUE,
+		.tiles = { {0, 0}, {0, 0}, {0, 0}, {0, 0}, {1, 0}, {2, 0} },
+		.mirroredFaces = FACE_BIT(FACE_BACK),
+	},
+	// dirt
+	{
+		.name = "dirt", .solid = true, .faces = ALL_FACES, .renderLayers = RENDER_LAYER_OPAQUE,
+		.tiles = { {1, 0}, {1, 0}, {1, 0}, {1, 0}, {1, 0}, {1, 0} },
+	},
+	// stone
+	{
+		.name = "stone", .solid = true, .faces = ALL_FACES, .renderLayers = RENDER_LAYER_OPAQUE,
+		.tiles = { {3, 0}, {3, 0}, {3, 0}, {3, 0}, {4, 0}, {5, 0} },
+	},
+	// sand
+	{
+		.name = "sand", .solid = true, .faces = ALL_FACES, .renderLayers = RENDER_LAYER_OPAQUE,
+		.tiles = { {6, 0}, {6, 0}, {6, 0}, {6, 0}, {6, 0}, {6, 0} },
+	},
+	// wood log
+	{
+		.name = "log", .solid = true, .faces = ALL_FACES, .renderLayers = RENDER_LAYER_OPAQUE,
+		.tiles = { {2, 1}, {2, 1}, {2, 1}, {2, 1}, {3, 1}, {3, 1} },
+	},
+	// leaves
+	{
+		.name = "leaves", .solid = true, .faces = ALL_FACES, .renderLayers = RENDER_LAYER_OPAQUE,
+		.tiles = { {4, 1}, {4, 1}, {4, 1}, {4, 1}, {4, 1}, {4, 1} },
+	},
+	// planks
+	{
+		.name = "planks", .solid = true, .faces = ALL_FACES, .renderLayers = RENDER_LAYER_OPAQUE,
+		.tiles = { {5, 1}, {5, 1}, {5, 1}, {5, 1}, {5, 1}, {5, 1} },
+	},
+	// stone bricks
+	{
+		.name = "bricks", .solid = true, .faces = ALL_FACES, .renderLayers = RENDER_LAYER_OPAQUE,
+		.tiles = { {6, 1}, {6, 1}, {6, 1}, {6, 1}, {6, 1}, {6, 1} },
+	},
+	// diamond
+	{
+		.name = "diamond", .solid = true, .faces = ALL_FACES, .renderLayers = RENDER_LAYER_OPAQUE,
+		.tiles = { {7, 1}, {7, 1}, {7, 1}, {7, 1}, {7, 1}, {7, 1} },
+	},
+	// smile
+	{
+		.name = "smile", .solid = true, .faces = ALL_FACES, .renderLayers = RENDER_LAYER_OPAQUE,
+		.tiles = { {8, 1}, {8, 1}, {8, 1}, {8, 1}, {9, 1}, {9, 1} },
+	},
+};
+
+
+// ---
+
+
+// gets the registry entry of a block type (unknown types get the air entry)
+const struct BlockInfo* get_block_info(int type) {
+	if(type < MIN_BLOCK_TYPE || type > MAX_BLOCK_TYPE) {
+		type = 0;
+	}
+
+	return &BLOCK_REGISTRY[type - MIN_BLOCK_TYPE];
+}
+
+// whether or not a block type hides the sides of the blocks next to it
+bool is_block_solid(int type) {
+	return (*get_block_info(type)).solid;
+}
+
+// takes an int and returns the string counterpart to that int block type
+const char* int_to_string_block_type(int type) {
+	// unknown types don't have a name
+	if(type < MIN_BLOCK_TYPE || type > MAX_BLOCK_TYPE) {
+		return NULL;
+	}
+
+	return BLOCK_REGISTRY[type - MIN_BLOCK_TYPE].name;
+}
+
+
+// ---
+
+
+// settings
+
+// index sizes a block storage can use, from smallest to biggest (all of them divide 64, so an index never straddles two words)
+const int STORAGE_BIT_SIZES[] = { 0, 1, 2, 4, 8 };
+
+
+// ---
+
+
+// gets the smallest index size that can address a palette of given size
+int get_storage_bits(int paletteSize) {
+	for(int i = 0; i < 5; i++) {
+		if( (1 << STORAGE_BIT_SIZES[i]) >= paletteSize ) {
+			return STORAGE_BIT_SIZES[i];
+		}
+	}
+	return 8;
+}
+
+// gets the amount of 64 bit words needed to hold blockAmount indices of given size
+int get_storage_words(int blockAmount, int bits) {
+	return (blockAmount*bits + 63) / 64;
+}
+
+
+// ---
+
+
+// initiates a block storage of given size that is filled with a single type
+void init_block_storage(struct BlockStorage* storage, int blockAmount, int type) {
+	(*storage).data = NULL;
+	(*storage).bits = 0;
+	(*storage).blockAmount = blockAmount;
+
+	(*storage).paletteSize = 1;
+	(*storage).palette[0] = type;
+}
+
+
+// ---
+
+
+// reads the palette index at an index of the packed data
+int get_storage_index(struct BlockStorage* storage, int index) {
+	if((*storage).bits == 0) {
+		return 0;
+	}
+
+	int bit = index * (*storage).bits;
+
+	return ( (*storage).data[bit >> 6] >> (bit & 63) ) & ( (1 << (*storage).bits) - 1 );
+}
+
+// writes a palette index at an index of the packed data
+void set_storage_index(struct BlockStorage* storage, int index, int paletteIndex) {
+	int bit = index * (*storage).bits;
+
+	uint64_t mask = (uint64_t)( (1 << (*storage).bits) - 1 ) << (bit & 63);
+
+	(*storage).data[bit >> 6] = ( (*storage).data[bit >> 6] & ~mask ) | ( (uint64_t)paletteIndex << (bit & 63) );
+}
+
+// gets the type of the block at an index of a block storage
+int get_storage_block(struct BlockStorage* storage, int index) {
+	return (*storage).palette[get_storage_index(storage, index)];
+}
+
+
+// ---
+
+
+// repacks the indices of a block storage into a different index size
+void resize_block_storage(struct BlockStorage* storage, int bits) {
+
+	// keep the old indices around to copy them over
+	struct BlockStorage old = *storage;
+
+	(*storage).bits = bits;
+	(*storage).data = calloc(get_storage_words((*storage).blockAmount, bits), sizeof(uint64_t));
+
+	for(int i = 0; i < (*storage).blockAmount; i++) {
+		set_storage_index(storage, i, get_storage_index(&old, i));
+	}
+
+	free(old.data);
+
+}
+
+// sets the type of the block at an index of a block storage
+void set_storage_block(struct BlockStorage* storage, int index, int type) {
+
+	// find the type in the palette
+	int paletteIndex = 0;
+
+	while(paletteIndex < (*storage).paletteSize && (*storage).palette[paletteIndex] != type) {
+		paletteIndex++;
+	}
+
+	// if its new then add it, going up an index size if the palette outgrew the current one
+	// (unused types are only dropped from the palette when the storage gets packed again)
+	if(paletteIndex == (*storage).paletteSize) {
+
+		(*storage).palette[paletteIndex] = type;
+		(*storage).paletteSize++;
+
+		int bits = get_storage_bits((*storage).paletteSize);
+
+		if(bits != (*storage).bits) {
+			resize_block_storage(storage, bits);
+		}
+
+	}
+
+	// a single type storage has no indices to write
+	if((*storage).bits != 0) {
+		set_storage_index(storage, index, paletteIndex);
+	}
+
+}
+
+
+// ---
+
+
+// replaces the contents of a block storage with an array of block types, using the smallest palette that fits them
+void pack_block_storage(struct BlockStorage* storage, const int8_t* types) {
+
+	// palette index of every possible type, -1 if its not in the palette yet
+	int paletteIndices[MAX_PALETTE_SIZE];
+
+	for(int i = 0; i < MAX_PALETTE_SIZE; i++) {
+		paletteIndices[i] = -1;
+	}
+
+	// build the palette out of the types that appear
+	(*storage).paletteSize = 0;
+
+	for(int i = 0; i < (*storage).blockAmount; i++) {
+		uint8_t type = types[i];
+
+		if(paletteIndices[type] == -1) {
+			paletteIndices[type] = (*storage).paletteSize;
+
+			(*storage).palette[(*storage).paletteSize] = types[i];
+			(*storage).paletteSize++;
+		}
+	}
+
+	// allocate the indices at the smallest size that fits the palette (nothing at all for a single type)
+	free((*storage).data);
+
+	(*storage).bits = get_storage_bits((*storage).paletteSize);
+	(*storage).data = NULL;
+
+	if((*storage).bits == 0) {
+		return;
+	}
+
+	int words = get_storage_words((*storage).blockAmount, (*storage).bits);
+
+	(*storage).data = malloc(sizeof(uint64_t) * words);
+
+	// pack the indices a whole word at a time
+	int perWord = 64 / (*storage).bits;
+
+	for(int w = 0; w < words; w++) {
+
+		uint64_t word = 0;
+
+		for(int i = 0; i < perWord && w*perWord + i < (*storage).blockAmount; i++) {
+			word |= (uint64_t)paletteIndices[ (uint8_t)types[w*perWord + i] ] << (i * (*storage).bits);
+		}
+
+		(*storage).data[w] = word;
+
+	}
+
+}
+
+// writes out the type of every block of a block storage into an array of block types
+void unpack_block_storage(struct BlockStorage* storage, int8_t* types) {
+
+	// a single type is just a fill
+	if((*storage).bits == 0) {
+		memset(types, (*storage).palette[0], (*storage).blockAmount);
+		return;
+	}
+
+	// unpack a whole word at a time
+	int bits = (*storage).bits;
+	int perWord = 64 / bits;
+	uint64_t mask = (1 << bits) - 1;
+
+	for(int i = 0; i < (*storage).blockAmount; i += perWord) {
+
+		uint64_t word = (*storage).data[i / perWord];
+
+		for(int j = 0; j < perWord && i+j < (*storage).blockAmount; j++) {
+			types[i+j] = (*storage).palette[word & mask];
+
+			word >>= bits;
+		}
+
+	}
+
+}
+
+
+// ---
+
+
+// gets the amount of memory held by a block storage in bytes
+int get_block_storage_size(struct BlockStorage* storage) {
+	return sizeof(struct BlockStorage) + sizeof(uint64_t) * get_storage_words((*storage).blockAmount, (*storage).bits);
+}
+
+// frees the memory held by a block storage, leaving it filled with air
+void free_block_storage(struct BlockStorage* storage) {
+	free((*storage).data);
+
+	init_block_storage(storage, (*storage).blockAmount, 0);
+}
+
+
+// ---
+
+
+// fills every section of a chunk with a single type
+void init_chunk_blocks(struct Chunk* chunk, int type) {
+	for(int i = 0; i < CHUNK_SECTIONS; i++) {
+		init_block_storage(&(*chunk).sections[i], SECTION_VOLUME, type);
+	}
+}
+
+// replaces the blocks of a chunk with an array of block types, one section at a time (they're stored in the same order)
+void pack_chunk_blocks(struct Chunk* chunk, const int8_t* types) {
+	for(int i = 0; i < CHUNK_SECTIONS; i++) {
+		pack_block_storage(&(*chunk).sections[i], types + i*SECTION_VOLUME);
+	}
+}
+
+// sets up a chunk at a position with all air blocks and no mesh (it gets space in the mesh arena upon the first upload)
+void init_chunk(struct Chunk* chunk, vec2 position) {
+
+	// all air, which doesn't need any memory for the blocks
+	init_chunk_blocks(chunk, 0);
+
+	// nothing to draw yet
+	(*chunk).indexCount = 0;
+
+	// nothing to block the view either
+	(*chunk).faceConnections = ALL_FACE_CONNECTIONS;
+	(*chunk).occluders = (struct ChunkOccluders){ 0 };
+
+	// no space in the mesh arena yet
+	for(int i = 0; i < CHUNK_SECTIONS; i++) {
+		(*chunk).meshes[i] = (struct ArenaMesh){ -1 };
+	}
+
+	// and nothing edited
+	(*chunk).dirtySections = 0;
+	(*chunk).cullingDirty = false;
+
+	// not linked up to any surrounding chunks yet
+	(*chunk).leftChunk = NULL;
+	(*chunk).rightChunk = NULL;
+	(*chunk).topChunk = NULL;
+	(*chunk).bottomChunk = NULL;
+
+	// apply position to chunk object
+	glm_vec2_copy(position, (*chunk).pos);
+
+}
+
+// gets the amount of memory held by the blocks of a chunk in bytes
+int get_chunk_blocks_size(struct Chunk* chunk) {
+	int size = 0;
+
+	for(int i = 0; i < CHUNK_SECTIONS; i++) {
+		size += get_block_storage_size(&(*chunk).sections[i]);
+	}
+
+	return size;
+}
+
+// frees the memory held by the blocks of a chunk, leaving it filled with air
+void free_chunk_blocks(struct Chunk* chunk) {
+	for(int i = 0; i < CHUNK_SECTIONS; i++) {
+		free_block_storage(&(*chunk).sections[i]);
+	}
+}
+
+// gets the type that every block of a chunk section is, or SECTION_MIXED if they aren't all the same
+int get_section_type(struct Chunk* chunk, int section) {
+	// only a single entry palette is known to be uniform without looking at the blocks
+	if((*chunk).sections[section].paletteSize == 1) {
+		return (*chunk).sections[section].palette[0];
+	}
+	return SECTION_MIXED;
+}
+
+
+// ---
+
+
+// gets the block type at a position relative to the chunk based on coordinates
+int get_block_type(struct Chunk* chunk, int xPos, int yPos, int zPos) {
+	return get_storage_block(&(*chunk).sections[yPos / SECTION_HEIGHT], (yPos % SECTION_HEIGHT)*CHUNK_WIDTH*CHUNK_LENGTH + zPos*CHUNK_LENGTH + xPos);
+}
+// returns the actual index of a block at given relative coordinates to chunk
+int get_block_index(int xPos, int yPos, int zPos) {
+	return yPos*CHUNK_WIDTH*CHUNK_LENGTH + zPos*CHUNK_LENGTH + xPos;
+}
+// sets the block type at a position relative to the chunk based on coordinates
+void set_block_type(struct Chunk* chunk, int xPos, int yPos, int zPos, int type) {
+	set_storage_block(&(*chunk).sections[yPos / SECTION_HEIGHT], (yPos % SECTION_HEIGHT)*CHUNK_WIDTH*CHUNK_LENGTH + zPos*CHUNK_LENGTH + xPos, type);
+}
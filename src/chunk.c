@@ -2,50 +2,28 @@
 #include "../include/GLFW/glfw3.h"
 #include "../include/CGLM/cglm.h"
 
-#include "../include/NOISE/noise1234.h"
-
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 
 #include "headers/mesh.h"
+#include "headers/mesh_builder.h"
+#include "headers/mesh_arena.h"
+#include "headers/chunk.h"
+#include "headers/blocks.h"
+#include "headers/mesher.h"
+#include "headers/terrain.h"
+#include "headers/culling.h"
 #include "headers/image.h"
 #include "headers/camera.h"
 #include "headers/sky.h"
 
-#include "headers/tex_coords.h"
-
 
 // ---
 
 
 // settings
-const int CHUNK_WIDTH  = 32;  // x
-const int CHUNK_HEIGHT = 32;  // y
-const int CHUNK_LENGTH = 32;  // z
-
-// noise settings
-const int NOISE_ZOOM = 50;
-const int NOISE_HEIGHT_OFFSET = 15;
-
-// level at which stone blocks appear, coming from top
-const int STONE_LEVEL = 5;
-
-// level at which sand blocks appear, coming from bottom
-const int SAND_LEVEL = 10;
-
-// chance of a tree spawning on a grass block (ranges from 0.0f - 1.0f)
-const float CHANCE_OF_TREE = 0.005f;
-
-// maximum and minimum tree height in blocks
-const int MAX_TREE_HEIGHT = 6;
-const int MIN_TREE_HEIGHT = 5;
-
-// trees can only be placed TREE_BUFFER_LEVEL amount of blocks below STONE_LEVEL
-const int TREE_BUFFER_LEVEL = 4;
-
-// water level (this is purely for rendering some stuff when under the water level)
-const float CAM_WATER_LEVEL = SAND_LEVEL+0.5;
 
 // boolean that checks if camera is under water
 bool underWaterLevel = false;
@@ -53,74 +31,6 @@ bool underWaterLevel = false;
 // boolean that states whether or not to have fog on
 bool showFog = true;
 
-// random noise offset
-float randomNoiseOffset = 0.0f;
-// divide random noise offset value by this
-const float RAND_NOISE_DIVIDER = 2000;
-
-
-// ---
-
-
-// takes an int and returns the string counterpart to that int block type
-const char* int_to_string_block_type(int type) {
-	// define type string based on returned block type
-	
-	switch(type) {
-		case 1:
-			return "grass";
-			break;
-
-		case 2:
-			return "dirt";
-			break;
-
-		case 3:
-			return "stone";
-			break;
-
-		case 4:
-			return "sand";
-			break;
-
-		case 5:
-			return "log";
-			break;
-
-		case 6:
-			return "leaves";
-			break;
-
-		case 7:
-			return "planks";
-			break;
-
-		case 8:
-			return "bricks";
-			break;
-
-		case 9:
-			return "diamond";
-			break;
-
-		case 10:
-			return "smile";
-			break;
-
-		case 0:
-			return "air";
-			break;
-
-		case -1:
-			return "water";
-			break;
-
-		default:
-			return NULL; // return NULL by default
-	}
-
-}
-
 
 // ---
 
@@ -134,16 +44,6 @@ void toggle_fog() {
 // ---
 
 
-// randomizes the noise offset
-void randomize_noise_offset() {
-	// set random noise offset
-	randomNoiseOffset = rand() / RAND_NOISE_DIVIDER;
-}
-
-
-// ---
-
-
 // getters for chunk sizes
 int get_chunk_width() { 
 	return CHUNK_WIDTH;
@@ -159,11 +59,6 @@ int get_chunk_height() {
 // ---
 
 
-// just returns the constant value of the camera water level float
-float get_water_level() {
-	return CAM_WATER_LEVEL;
-}
-
 // getter for under water-level
 bool get_under_water_level() {
 	return underWaterLevel;
@@ -178,1913 +73,376 @@ void set_under_water_level(bool value) {
 // ---
 
 
-// calculates noise value as integer block y coordinate at given position, allows for offsetting with chunk coords
-int calc_chunk_noise_value(vec2 position, vec2 chunkOffset) {
-	return (int) ( 
-						noise2(
-							(float) ( position[0] + chunkOffset[0]*CHUNK_WIDTH + randomNoiseOffset ) / NOISE_ZOOM, 
-							(float) ( position[1] + chunkOffset[1]*CHUNK_LENGTH + randomNoiseOffset ) / NOISE_ZOOM
-						) * CHUNK_HEIGHT
-					 ) + NOISE_HEIGHT_OFFSET;
-}
-
-
-// ---
-
-
-// chunk structure
-struct Chunk {
-	vec2 pos; // multiplied by CHUNK_WIDTH and CHUNK_LENGTH
-	
-	int sides; // how many sides do render (used when drawing it)
-	
-	int* blockTypes; // array of block types
-	
-	struct Mesh mesh; // mesh of chunk
-};
-
-
-// ---
-
+// staging buffer that chunk meshes are built into on the cpu before being uploaded
+struct MeshBuilder chunkMeshBuilder;
 
-// gets the block type at a position relative to the chunk based on coordinates
-int get_block_type(int* blockTypes, int xPos, int yPos, int zPos) {
-	return blockTypes[yPos*CHUNK_WIDTH*CHUNK_LENGTH + zPos*CHUNK_LENGTH + xPos];
-}
-// returns the actual index of a block at given relative coordinates to chunk
-int get_block_index(int* blockTypes, int xPos, int yPos, int zPos) {
-	return yPos*CHUNK_WIDTH*CHUNK_LENGTH + zPos*CHUNK_LENGTH + xPos;
-}
-// sets the block type at a position relative to the chunk based on coordinates
-void set_block_type(int* blockTypes, int xPos, int yPos, int zPos, int type) {
-	blockTypes[yPos*CHUNK_WIDTH*CHUNK_LENGTH + zPos*CHUNK_LENGTH + xPos] = type;
-}
+// amount of chunks the water chunk covers along each side
+int waterSize = 0;
 
 
 // ---
 
 
-// creates a side vertices array from a template based on inputted side and coordinates, and writes it to given array
-void create_side_vertices(const char* side, const char* blockType, int xPos, int yPos, int zPos, float* array) {
-
-	// create initial coordinate values for vertices array
-	float x1, y1, z1;
-	float x2, y2, z2;
-	float x3, y3, z3;
-	float x4, y4, z4;
-
-	// y position offset
-	float yOff = 0;
-
-	// declare and define color values (defaults are 1.0f)
-	float r = 1.0f, g = 1.0f, b = 1.0f;
-
-	// declare texture coordinates
-	int tex_x1, tex_y1;
-	int tex_x2, tex_y2;
-	int tex_x3, tex_y3;
-	int tex_x4, tex_y4;
-
-	// texture offset for indexing a pre-made tex coords array
-	int textureOffset;
+// marks a built mesh with the chunk's slot and uploads each of its sections into the space of that section in the mesh arena,
+// replacing whatever was there before (main thread only), the chunks are drawn all at once, so the shader finds their positions
+// by their slots
+void upload_chunk_mesh(struct Chunk* chunk, int slot, struct MeshBuilder* builder) {
 
-	// declare texture coordinate values
-	int texCoords[8*6];
-
-	// load texture coordinates based on block type
-	if(strcmp(blockType, "grass") == 0) {
-		// copy grass texture coords array to tex_coords
-		memcpy(texCoords, GRASS_TEX_COORDS, sizeof(int) * 8*6);
-	}
-	else if(strcmp(blockType, "dirt") == 0) {
-		// copy dirt texture coords array to tex_coords
-		memcpy(texCoords, DIRT_TEX_COORDS, sizeof(int) * 8*6);
-	}
-	else if(strcmp(blockType, "stone") == 0) {
-		// copy stone texture coords array to tex_coords
-		memcpy(texCoords, STONE_TEX_COORDS, sizeof(int) * 8*6);
-	}
-	else if(strcmp(blockType, "sand") == 0) {
-		// copy sand texture coords array to tex_coords
-		memcpy(texCoords, SAND_TEX_COORDS, sizeof(int) * 8*6);
-	}
-	else if(strcmp(blockType, "log") == 0) {
-		// copy wood log texture coords array to tex_coords
-		memcpy(texCoords, LOG_TEX_COORDS, sizeof(int) * 8*6);
-	}
-	else if(strcmp(blockType, "leaves") == 0) {
-		// copy leaves texture coords array to tex_coords
-		memcpy(texCoords, LEAVES_TEX_COORDS, sizeof(int) * 8*6);
-	}
-	else if(strcmp(blockType, "planks") == 0) {
-		// copy planks texture coords array to tex_coords
-		memcpy(texCoords, PLANKS_TEX_COORDS, sizeof(int) * 8*6);
-	}
-	else if(strcmp(blockType, "bricks") == 0) {
-		// copy bricks texture coords array to tex_coords
-		memcpy(texCoords, BRICKS_TEX_COORDS, sizeof(int) * 8*6);
-	}
-	else if(strcmp(blockType, "diamond") == 0) {
-		// copy diamond texture coords array to tex_coords
-		memcpy(texCoords, DIAMOND_TEX_COORDS, sizeof(int) * 8*6);
-	}
-	else if(strcmp(blockType, "smile") == 0) {
-		// copy smile texture coords array to tex_coords
-		memcpy(texCoords, SMILE_TEX_COORDS, sizeof(int) * 8*6);
-	}
-	else if(strcmp(blockType, "water") == 0) {
-		// copy sand texture coords array to tex_coords
-		memcpy(texCoords, WATER_TEX_COORDS, sizeof(int) * 8*6);
-		
-		yOff = 0.2f;
+	// the slot goes in the top bits of the first word of every vertex (face records don't have room for it, the arena
+	// keeps track of it for them)
+	if(!(*builder).faceRecords) {
+		for(int i = 0; i < (*builder).vertexCount; i += VERTEX_WORDS) {
+			(*builder).vertices[i] |= (uint32_t)slot << VERTEX_SLOT_SHIFT;
+		}
 	}
 
-	// compare side string to string literals and define coordinate floats, as well as set texture offset
-	if(strcmp(side, "front") == 0) {
-		x1 = 0.0f; y1 = 1.0f; z1 = 1.0f;
-		x2 = 1.0f; y2 = 1.0f; z2 = 1.0f;
-		x3 = 0.0f; y3 = 0.0f; z3 = 1.0f;
-		x4 = 1.0f; y4 = 0.0f; z4 = 1.0f;
+	// upload every section that was built in one go
+	for(int section = (*builder).firstSection; section < (*builder).firstSection + (*builder).sectionCount; section++) {
 
-		r = 0.9f; g = 0.9f; b = 0.9f;
+		int start;
+		int count;
+		get_mesh_section(builder, section, &start, &count);
 
-		textureOffset = 0;
-	}
-	else if(strcmp(side, "back") == 0) {
-		x1 = 0.0f; y1 = 1.0f; z1 = 0.0f;
-		x2 = 1.0f; y2 = 1.0f; z2 = 0.0f;
-		x3 = 0.0f; y3 = 0.0f; z3 = 0.0f;
-		x4 = 1.0f; y4 = 0.0f; z4 = 0.0f;
+		if((*builder).faceRecords) {
 
-		r = 0.85f; g = 0.85f; b = 0.85f;
+			// the face arena can't grow any further, so go back to meshing into vertices, the section stays dirty and gets
+			// rebuilt as them with the next remesh_dirty_chunks (the face meshes already in the arena are still drawn)
+			if(!upload_arena_faces(&(*chunk).meshes[section], (*builder).vertices + start, count, slot)) {
+				if(get_vertex_pulling()) {
+					toggle_vertex_pulling();
 
-		textureOffset = 8;
-	}
-	else if(strcmp(side, "left") == 0) {
-		x1 = 0.0f; y1 = 1.0f; z1 = 0.0f;
-		x2 = 0.0f; y2 = 1.0f; z2 = 1.0f;
-		x3 = 0.0f; y3 = 0.0f; z3 = 0.0f;
-		x4 = 0.0f; y4 = 0.0f; z4 = 1.0f;
+					printf("Face arena is full, vertex pulling turned off\n");
+				}
 
-		r = 0.75f; g = 0.75f; b = 0.75f;
+				(*chunk).dirtySections |= 1 << section;
+				continue;
+			}
 
-		textureOffset = 16;
-	}
-	else if(strcmp(side, "right") == 0) {
-		x1 = 1.0f; y1 = 1.0f; z1 = 1.0f;
-		x2 = 1.0f; y2 = 1.0f; z2 = 0.0f;
-		x3 = 1.0f; y3 = 0.0f; z3 = 1.0f;
-		x4 = 1.0f; y4 = 0.0f; z4 = 0.0f;
+		}
+		else {
+			upload_arena_mesh(&(*chunk).meshes[section], (*builder).vertices + start, count / VERTEX_WORDS);
+		}
 
-		r = 0.9f; g = 0.9f; b = 0.9f;
+		// its up to date now
+		(*chunk).dirtySections &= ~(1 << section);
 
-		textureOffset = 24;
 	}
-	else if(strcmp(side, "bottom") == 0) {
-		x1 = 0.0f; y1 = 0.0f; z1 = 1.0f;
-		x2 = 1.0f; y2 = 0.0f; z2 = 1.0f;
-		x3 = 0.0f; y3 = 0.0f; z3 = 0.0f;
-		x4 = 1.0f; y4 = 0.0f; z4 = 0.0f;
-
-		r = 0.7f; g = 0.7f; b = 0.7f;
 
-		textureOffset = 32;
-	}
-	else if(strcmp(side, "top") == 0) {
-		x1 = 0.0f; y1 = 1.0f; z1 = 1.0f;
-		x2 = 1.0f; y2 = 1.0f; z2 = 1.0f;
-		x3 = 0.0f; y3 = 1.0f; z3 = 0.0f;
-		x4 = 1.0f; y4 = 1.0f; z4 = 0.0f;
+	// store exact amount of indices for drawing
+	(*chunk).indexCount = 0;
 
-		textureOffset = 40;
+	for(int section = 0; section < CHUNK_SECTIONS; section++) {
+		(*chunk).indexCount += get_arena_mesh_faces(&(*chunk).meshes[section]) * 6;
 	}
 
-	// assign texture coordinates
-	tex_x1 = texCoords[0+textureOffset]; tex_y1 = texCoords[1+textureOffset];
-	tex_x2 = texCoords[2+textureOffset]; tex_y2 = texCoords[3+textureOffset];
-	tex_x3 = texCoords[4+textureOffset]; tex_y3 = texCoords[5+textureOffset];
-	tex_x4 = texCoords[6+textureOffset]; tex_y4 = texCoords[7+textureOffset];
-
-	// generate vertices array
-	float sideVertices[] = {
-		// position                          color       texture coords
-
-		x1+xPos,  y1+yPos-yOff,  z1+zPos,    r, g, b,    calc_at_tex_x(tex_x1), calc_at_tex_y(tex_y1),  // top left
-		x2+xPos,  y2+yPos-yOff,  z2+zPos,    r, g, b,    calc_at_tex_x(tex_x2), calc_at_tex_y(tex_y2),  // top right
-		x3+xPos,  y3+yPos-yOff,  z3+zPos,    r, g, b,    calc_at_tex_x(tex_x3), calc_at_tex_y(tex_y3),  // bot left
-		x4+xPos,  y4+yPos-yOff,  z4+zPos,    r, g, b,    calc_at_tex_x(tex_x4), calc_at_tex_y(tex_y4),  // bot right
-	};
-
-	// copy contents of new sideVertices array into passed in array
-	memcpy(array, sideVertices, sizeof(float) * 4*8);
-
-}
-
-
-// ---
-
-
-// creates a side indices array from a template based on indices offset and index, and writes it to given array
-void create_side_indices(int indicesOffset, int index, int* array) {
-
-	// generate indices array
-	int sideIndices[] = {
-		indicesOffset+(index*24), indicesOffset+1+(index*24), indicesOffset+2+(index*24),
-		indicesOffset+1+(index*24), indicesOffset+2+(index*24), indicesOffset+3+(index*24),
-	};
-
-	// copy contents of new sideIndices array into passed in array
-	memcpy(array, sideIndices, sizeof(int) * 6);
-
 }
 
 
 // ---
 
 
-void insert_block(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, vec4 block) {
-
-	// set the block type in the main chunk
-	set_block_type((*chunk).blockTypes, block[0], block[1], block[2], block[3]);
-
-	// bind vao
-	glBindVertexArray((*chunk).mesh.vao);
-
-	// bind vbo and ebo
-	glBindBuffer(GL_ARRAY_BUFFER, (*chunk).mesh.vbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (*chunk).mesh.ebo);
-
-	// define side vertices arrays for each side of a block
-	float sideVertices[4*8];
-
-	// create single side indices array
-	int sideIndices[6];
+// marks the sections whose meshes a changed block affects as dirty
+void mark_block_dirty(struct Chunk* chunk, int xPos, int yPos, int zPos) {
 
-	// declare type string
-	const char* type;
+	int section = yPos / SECTION_HEIGHT;
 
-	// convert type to string
-	type = int_to_string_block_type(block[3]);
+	(*chunk).dirtySections |= 1 << section;
+	(*chunk).cullingDirty = true;
 
-
-	int verticesIndex = 0;
-	int indicesIndex = 0;
-	int indicesOffset = 0;
-
-	// get index of block
-	int i = get_block_index((*chunk).blockTypes, block[0], block[1], block[2]);
-
-
-	// ---
-
-
-	// front
-
-	// if not air block
-	if(block[3] != 0) {
-		// generate proper vertices array and load it into frontVertices
-		create_side_vertices("front", type, block[0], block[1], block[2], sideVertices);
-		
-		// generate proper indices array and load it into sideIndices
-		create_side_indices(indicesOffset, i, sideIndices);
+	// the block below or above it is in another section, so the side facing it is in that section's mesh
+	if(yPos % SECTION_HEIGHT == 0 && section > 0) {
+		(*chunk).dirtySections |= 1 << (section-1);
 	}
-
-	// load proper vertices and indices array into VBO via glBufferSubData
-	glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + verticesIndex, sizeof(sideVertices), sideVertices);
-	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + indicesIndex, sizeof(sideIndices), sideIndices);
-
-	// increment vertices and indices index, as well as indices offset
-	verticesIndex += 4*8 * sizeof(float);
-	indicesIndex += 6 * sizeof(int);
-	indicesOffset += 4;
-
-	// increment amount of sides
-	(*chunk).sides += 6;
-
-
-	// ---
-	
-
-	// back
-	
-	// if not air block
-	if(block[3] != 0) {
-		// generate proper vertices array and load it into frontVertices
-		create_side_vertices("back", type, block[0], block[1], block[2], sideVertices);
-		
-		// generate proper indices array and load it into sideIndices
-		create_side_indices(indicesOffset, i, sideIndices);
+	if(yPos % SECTION_HEIGHT == SECTION_HEIGHT-1 && section < CHUNK_SECTIONS-1) {
+		(*chunk).dirtySections |= 1 << (section+1);
 	}
 
-	// load proper vertices and indices array into VBO via glBufferSubData
-	glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + verticesIndex, sizeof(sideVertices), sideVertices);
-	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + indicesIndex, sizeof(sideIndices), sideIndices);
-
-	// increment vertices and indices index, as well as indices offset
-	verticesIndex += 4*8 * sizeof(float);
-	indicesIndex += 6 * sizeof(int);
-	indicesOffset += 4;
-
-	// increment amount of sides
-	(*chunk).sides += 6;
-
-
-	// ---
-	
-
-	// left
-
-	// if not air block
-	if(block[3] != 0) {
-		// generate proper vertices array and load it into frontVertices
-		create_side_vertices("left", type, block[0], block[1], block[2], sideVertices);
-		
-		// generate proper indices array and load it into sideIndices
-		create_side_indices(indicesOffset, i, sideIndices);
+	// if the block sits on the border of the chunk, the surrounding chunk on that side has a side facing it as well
+	if(xPos == 0 && (*chunk).leftChunk != NULL) {
+		(*(*chunk).leftChunk).dirtySections |= 1 << section;
 	}
-
-	// load proper vertices and indices array into VBO via glBufferSubData
-	glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + verticesIndex, sizeof(sideVertices), sideVertices);
-	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + indicesIndex, sizeof(sideIndices), sideIndices);
-
-	// increment vertices and indices index, as well as indices offset
-	verticesIndex += 4*8 * sizeof(float);
-	indicesIndex += 6 * sizeof(int);
-	indicesOffset += 4;
-
-	// increment amount of sides
-	(*chunk).sides += 6;
-
-
-	// ---
-	
-
-	// right
-
-	// if not air block
-	if(block[3] != 0) {
-		// generate proper vertices array and load it into frontVertices
-		create_side_vertices("right", type, block[0], block[1], block[2], sideVertices);
-		
-		// generate proper indices array and load it into sideIndices
-		create_side_indices(indicesOffset, i, sideIndices);
+	if(xPos == CHUNK_WIDTH-1 && (*chunk).rightChunk != NULL) {
+		(*(*chunk).rightChunk).dirtySections |= 1 << section;
 	}
-
-	// load proper vertices and indices array into VBO via glBufferSubData
-	glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + verticesIndex, sizeof(sideVertices), sideVertices);
-	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + indicesIndex, sizeof(sideIndices), sideIndices);
-
-	// increment vertices and indices index, as well as indices offset
-	verticesIndex += 4*8 * sizeof(float);
-	indicesIndex += 6 * sizeof(int);
-	indicesOffset += 4;
-
-	// increment amount of sides
-	(*chunk).sides += 6;
-
-
-	// ---
-	
-
-	// bottom
-
-	// if not air block
-	if(block[3] != 0) {
-		// generate proper vertices array and load it into frontVertices
-		create_side_vertices("bottom", type, block[0], block[1], block[2], sideVertices);
-		
-		// generate proper indices array and load it into sideIndices
-		create_side_indices(indicesOffset, i, sideIndices);
+	if(zPos == 0 && (*chunk).bottomChunk != NULL) {
+		(*(*chunk).bottomChunk).dirtySections |= 1 << section;
 	}
-
-	// load proper vertices and indices array into VBO via glBufferSubData
-	glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + verticesIndex, sizeof(sideVertices), sideVertices);
-	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + indicesIndex, sizeof(sideIndices), sideIndices);
-
-	// increment vertices and indices index, as well as indices offset
-	verticesIndex += 4*8 * sizeof(float);
-	indicesIndex += 6 * sizeof(int);
-	indicesOffset += 4;
-
-	// increment amount of sides
-	(*chunk).sides += 6;
-
-
-	// ---
-	
-
-	// top
-
-	// if not air block
-	if(block[3] != 0) {
-		// generate proper vertices array and load it into frontVertices
-		create_side_vertices("top", type, block[0], block[1], block[2], sideVertices);
-		
-		// generate proper indices array and load it into sideIndices
-		create_side_indices(indicesOffset, i, sideIndices);
+	if(zPos == CHUNK_LENGTH-1 && (*chunk).topChunk != NULL) {
+		(*(*chunk).topChunk).dirtySections |= 1 << section;
 	}
 
-	// load proper vertices and indices array into VBO via glBufferSubData
-	glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + verticesIndex, sizeof(sideVertices), sideVertices);
-	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + indicesIndex, sizeof(sideIndices), sideIndices);
-
-	// increment amount of sides
-	(*chunk).sides += 6;
-
-
-	// ---
-	
-
-	// now we need to get adjacent blocks and fill in their sides, if new block is air
-	if(block[3] == 0) {
-
-		// the blocks are actually done kinda in reverse so the front block is actually the back block of
-		// the main block being edited, and the right block is actually left to the main block, but its right side is being edited
-		// which is why its being called the right block, i know its a bit confusing
-
-		// front block
-
-		// front position vector
-		vec3 frontPos;
-		glm_vec3_copy((vec3){block[0], block[1], block[2]-1}, frontPos);
-
-		// if front block isnt air and position is within chunk
-		if(get_block_type((*chunk).blockTypes, frontPos[0], frontPos[1], frontPos[2]) != 0 && frontPos[2] >= 0) {
-
-			// get block type in the form of integer
-			int blockType = get_block_type((*chunk).blockTypes, frontPos[0], frontPos[1], frontPos[2]);
-
-			// get index of block
-			int blockIndex = get_block_index((*chunk).blockTypes, frontPos[0], frontPos[1], frontPos[2]);
-
-			// define type string based on returned block type
-			type = int_to_string_block_type(blockType);
-
-
-			// generate proper vertices array and load it into sideVertices
-			create_side_vertices("front", type, frontPos[0], frontPos[1], frontPos[2], sideVertices);
-			
-			// generate proper indices array and load it into sideIndices
-			create_side_indices( 0*(4) , blockIndex, sideIndices);
-
-			// load proper vertices and indices array into VBO via glBufferSubData
-			glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * blockIndex + 0*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * blockIndex + 0*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
-
-			// increment amount of sides
-			(*chunk).sides += 6;
-
-		}
+}
 
-		// back block
+// inserts a block into a chunk and marks the sections it affects as dirty (they get rebuilt by remesh_dirty_sections)
+void insert_block(struct Chunk* chunk, vec4 block) {
 
-		// back position vector
-		vec3 backPos;
-		glm_vec3_copy((vec3){block[0], block[1], block[2]+1}, backPos);
-		
-		// if back block isnt air and position is within chunk
-		if(get_block_type((*chunk).blockTypes, backPos[0], backPos[1], backPos[2]) != 0 && backPos[2] <= CHUNK_LENGTH-1) {
+	// set the block type in the main chunk
+	set_block_type(chunk, block[0], block[1], block[2], block[3]);
 
-			// get block type in the form of integer
-			int blockType = get_block_type((*chunk).blockTypes, backPos[0], backPos[1], backPos[2]);
+	// and mark whatever has to be rebuilt because of it
+	mark_block_dirty(chunk, block[0], block[1], block[2]);
 
-			// get index of block
-			int blockIndex = get_block_index((*chunk).blockTypes, backPos[0], backPos[1], backPos[2]);
+}
 
-			// define type string based on returned block type
-			type = int_to_string_block_type(blockType);
+// rebuilds the dirty sections of a chunk against its surrounding chunks, a run of dirty sections next to each other at a time
+void remesh_dirty_sections(struct Chunk* chunk, int slot) {
 
+	// the edits may have opened up or closed off a way thru the chunk, or hidden more behind it
+	if((*chunk).cullingDirty) {
+		update_chunk_culling(chunk);
 
-			// generate proper vertices array and load it into sideVertices
-			create_side_vertices("back", type, backPos[0], backPos[1], backPos[2], sideVertices);
-			
-			// generate proper indices array and load it into sideIndices
-			create_side_indices( 1*(4) , blockIndex, sideIndices);
+		(*chunk).cullingDirty = false;
+	}
 
-			// load proper vertices and indices array into VBO via glBufferSubData
-			glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * blockIndex + 1*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * blockIndex + 1*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
+	int section = 0;
 
-			// increment amount of sides
-			(*chunk).sides += 6;
+	while(section < CHUNK_SECTIONS) {
 
+		if(!((*chunk).dirtySections & (1 << section))) {
+			section++;
+			continue;
 		}
 
-		// left block
-
-		// left position vector
-		vec3 leftPos;
-		glm_vec3_copy((vec3){block[0]+1, block[1], block[2]}, leftPos);
-		
-		// if left block isnt air
-		if(get_block_type((*chunk).blockTypes, leftPos[0], leftPos[1], leftPos[2]) != 0 && leftPos[0] <= CHUNK_WIDTH-1) {
-
-			// get block type in the form of integer
-			int blockType = get_block_type((*chunk).blockTypes, leftPos[0], leftPos[1], leftPos[2]);
-
-			// get index of block
-			int blockIndex = get_block_index((*chunk).blockTypes, leftPos[0], leftPos[1], leftPos[2]);
-
-			// define type string based on returned block type
-			type = int_to_string_block_type(blockType);
-
-
-			// generate proper vertices array and load it into sideVertices
-			create_side_vertices("left", type, leftPos[0], leftPos[1], leftPos[2], sideVertices);
-			
-			// generate proper indices array and load it into sideIndices
-			create_side_indices( 2*(4) , blockIndex, sideIndices);
-
-			// load proper vertices and indices array into VBO via glBufferSubData
-			glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * blockIndex + 2*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * blockIndex + 2*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
-
-			// increment amount of sides
-			(*chunk).sides += 6;
+		// find where the run ends
+		int lastSection = section;
 
+		while(lastSection+1 < CHUNK_SECTIONS && ((*chunk).dirtySections & (1 << (lastSection+1)))) {
+			lastSection++;
 		}
 
-		// right block
-
-		// right position vector
-		vec3 rightPos;
-		glm_vec3_copy((vec3){block[0]-1, block[1], block[2]}, rightPos);
-		
-		// if right block isnt air and position is within chunk
-		if(get_block_type((*chunk).blockTypes, rightPos[0], rightPos[1], rightPos[2]) != 0 && rightPos[0] >= 0) {
-
-			// get block type in the form of integer
-			int blockType = get_block_type((*chunk).blockTypes, rightPos[0], rightPos[1], rightPos[2]);
-
-			// get index of block
-			int blockIndex = get_block_index((*chunk).blockTypes, rightPos[0], rightPos[1], rightPos[2]);
+		// build the sections on the cpu, and upload them (which marks them as up to date)
+		build_chunk_sections(chunk, (*chunk).leftChunk, (*chunk).rightChunk, (*chunk).topChunk, (*chunk).bottomChunk,
+			section, lastSection, &chunkMeshBuilder);
 
-			// define type string based on returned block type
-			type = int_to_string_block_type(blockType);
+		upload_chunk_mesh(chunk, slot, &chunkMeshBuilder);
 
+		section = lastSection+1;
 
-			// generate proper vertices array and load it into sideVertices
-			create_side_vertices("right", type, rightPos[0], rightPos[1], rightPos[2], sideVertices);
-			
-			// generate proper indices array and load it into sideIndices
-			create_side_indices( 3*(4) , blockIndex, sideIndices);
+	}
 
-			// load proper vertices and indices array into VBO via glBufferSubData
-			glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * blockIndex + 3*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * blockIndex + 3*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
+}
 
-			// increment amount of sides
-			(*chunk).sides += 6;
 
-		}
+// ---
 
-		// bottom block
 
-		// bottom position vector
-		vec3 bottomPos;
-		glm_vec3_copy((vec3){block[0], block[1]+1, block[2]}, bottomPos);
-		
-		// if bottom block isnt air and position is within chunk
-		if(get_block_type((*chunk).blockTypes, bottomPos[0], bottomPos[1], bottomPos[2]) != 0) {
+// generates the water, which isn't in a slot of the loaded chunks (see draw_chunk)
+struct Chunk generate_water_chunk(vec2 position, int world_size) {
 
-			// get block type in the form of integer
-			int blockType = get_block_type((*chunk).blockTypes, bottomPos[0], bottomPos[1], bottomPos[2]);
+	// create new chunk structure instance
+	struct Chunk newChunk;
 
-			// get index of block
-			int blockIndex = get_block_index((*chunk).blockTypes, bottomPos[0], bottomPos[1], bottomPos[2]);
+	// set up the chunk at its position
+	init_chunk(&newChunk, position);
 
-			// define type string based on returned block type
-			type = int_to_string_block_type(blockType);
+	// clear whatever was built before (the water is always drawn from vertices)
+	reset_mesh_builder(&chunkMeshBuilder);
 
+	chunkMeshBuilder.faceRecords = false;
 
-			// generate proper vertices array and load it into sideVertices
-			create_side_vertices("bottom", type, bottomPos[0], bottomPos[1], bottomPos[2], sideVertices);
-			
-			// generate proper indices array and load it into sideIndices
-			create_side_indices( 4*(4) , blockIndex, sideIndices);
+	// top vertices array
+	uint32_t topVertices[4*VERTEX_WORDS];
 
-			// load proper vertices and indices array into VBO via glBufferSubData
-			glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * blockIndex + 4*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * blockIndex + 4*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
+	// a single water side stretched across every chunk, as the vertex positions only go up to the size of a chunk,
+	// each one is in its own slot, which is offset by how far along it is in the world (see draw_chunk)
+	for(int slot = 0; slot < world_size*world_size; slot++) {
 
-			// increment amount of sides
-			(*chunk).sides += 6;
+		// generate proper vertices array and load it into topVertices
+		create_side_vertices(FACE_TOP, -1, 0, get_sand_level()-1, 0, CHUNK_WIDTH, CHUNK_LENGTH, topVertices);
 
+		for(int c = 0; c < 4; c++) {
+			topVertices[c*VERTEX_WORDS] |= slot << VERTEX_SLOT_SHIFT;
 		}
 
-		// top block
-
-		// top position vector
-		vec3 topPos;
-		glm_vec3_copy((vec3){block[0], block[1]-1, block[2]}, topPos);
-		
-		// if top block isnt air
-		if(get_block_type((*chunk).blockTypes, topPos[0], topPos[1], topPos[2]) != 0) {
-
-			// get block type in the form of integer
-			int blockType = get_block_type((*chunk).blockTypes, topPos[0], topPos[1], topPos[2]);
-
-			// get index of block
-			int blockIndex = get_block_index((*chunk).blockTypes, topPos[0], topPos[1], topPos[2]);
-
-			// define type string based on returned block type
-			type = int_to_string_block_type(blockType);
-
-
-			// generate proper vertices array and load it into sideVertices
-			create_side_vertices("top", type, topPos[0], topPos[1], topPos[2], sideVertices);
-			
-			// generate proper indices array and load it into sideIndices
-			create_side_indices( 5*(4) , blockIndex, sideIndices);
-
-			// load proper vertices and indices array into VBO via glBufferSubData
-			glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * blockIndex + 5*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * blockIndex + 5*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
-
-			// increment amount of sides
-			(*chunk).sides += 6;
-
-		}
+		// append it to the mesh
+		push_mesh_face(&chunkMeshBuilder, topVertices);
 
 	}
 
-	// unbind vbo and ebo
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	waterSize = world_size;
 
+	// upload the built mesh in one go
+	upload_arena_mesh(&newChunk.meshes[0], chunkMeshBuilder.vertices, chunkMeshBuilder.vertexCount / VERTEX_WORDS);
 
+	newChunk.indexCount = chunkMeshBuilder.indexCount;
 
-	// ---
-	
-
-	// bind vao
-	glBindVertexArray((*chunk).mesh.vao);
+	// return newly generated chunk object
+	return newChunk;
 
-	// bind vbo and ebo
-	glBindBuffer(GL_ARRAY_BUFFER, (*chunk).mesh.vbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (*chunk).mesh.ebo);
+}
 
-	// vertex attributes
-	
-	// position
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
 
-	// color
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-	glEnableVertexAttribArray(1);
+// ---
 
-	// texture coords
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-	glEnableVertexAttribArray(2);
 
-	// now unbind everything
-	glBindVertexArray(0);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+// rebuilds the mesh of a chunk with its linked surrounding chunks taken into account, so faces hidden by them are removed
+// (a NULL surrounding chunk means its the edge of the world, which the sides facing it are visible from)
+void handle_chunk_sides(struct Chunk* chunk, int slot) {
 
+	// build the mesh on the cpu
+	build_chunk_mesh(chunk, (*chunk).leftChunk, (*chunk).rightChunk, (*chunk).topChunk, (*chunk).bottomChunk, &chunkMeshBuilder);
 
-	// ---
-	
+	// and upload it
+	upload_chunk_mesh(chunk, slot, &chunkMeshBuilder);
 
-	// now we want to deal with the extra chunks if the operation was a deletion operation
-	
-	// if block being placed is air
-	if(block[3] == 0) {
+}
 
-		// front block
 
-		// front position vector
-		vec3 frontPos;
-		glm_vec3_copy((vec3){block[0], block[1], block[2]-1}, frontPos);
+// ---
 
-		// if front block position leaks into the side of the other chunk AND the chunk exists AND the block in that chunk isnt an air block (in this exact order)
-		if( frontPos[2] == -1 && topChunk != NULL && get_block_type((*topChunk).blockTypes, frontPos[0], frontPos[1], CHUNK_LENGTH-1) != 0 ) {
 
-			// bind vao
-			glBindVertexArray((*topChunk).mesh.vao);
+// sets up the shader program, atlas and uniforms for drawing chunks, with the offsets of the chunk slots their vertices are in
+void use_chunk_shader(unsigned int shaderProgram, unsigned int worldAtlas, vec2* offsets, int offsetCount, bool water, bool drawingWater) {
 
-			// bind vbo and ebo
-			glBindBuffer(GL_ARRAY_BUFFER, (*topChunk).mesh.vbo);
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (*topChunk).mesh.ebo);
+	// use shader program
+	glUseProgram(shaderProgram);
 
+	// bind texture
+	glBindTexture(GL_TEXTURE_2D, worldAtlas);
 
-			// ---
+	// get camera matrices
+	mat4* model = get_model();
+	mat4* view = get_view();
+	mat4* proj = get_projection();
 
+	// get camera position
+	vec3* camPos = get_camera_pos();
 
-			// get block type in the form of integer
-			int blockType = get_block_type((*topChunk).blockTypes, frontPos[0], frontPos[1], CHUNK_LENGTH-1);
+	// get block shading
+	float shading = get_block_shading();
 
-			// get index of block
-			int blockIndex = get_block_index((*topChunk).blockTypes, frontPos[0], frontPos[1], CHUNK_LENGTH-1);
+	// get locations of uniform camera matrices
+	int modelLoc = glGetUniformLocation(shaderProgram, "model");
+	int viewLoc = glGetUniformLocation(shaderProgram, "view");
+	int projLoc = glGetUniformLocation(shaderProgram, "proj");
 
-			// define type string based on returned block type
-			type = int_to_string_block_type(blockType);
+	// get location of chunk offsets uniform array
+	int posLoc = glGetUniformLocation(shaderProgram, "chunkOffsets");
 
+	// get location of underwater uniform
+	int uwLoc = glGetUniformLocation(shaderProgram, "underWater");
 
-			// generate proper vertices array and load it into sideVertices
-			create_side_vertices("front", type, frontPos[0], frontPos[1], CHUNK_LENGTH-1, sideVertices);
-			
-			// generate proper indices array and load it into sideIndices
-			create_side_indices( 0*(4) , blockIndex, sideIndices);
+	// get location of uniform shading float
+	int shadingLoc = glGetUniformLocation(shaderProgram, "shading");
 
-			// load proper vertices and indices array into VBO via glBufferSubData
-			glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * blockIndex + 0*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * blockIndex + 0*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
+	// get location of uniform tide float
+	int tideLoc = glGetUniformLocation(shaderProgram, "tide");
 
-			// increment amount of sides
-			(*topChunk).sides += 6;
+	// get location of camera position uniform vector
+	int camPosLoc = glGetUniformLocation(shaderProgram, "camPos");
 
-			
-			// ---
+	// get location of uniform boolean for showing fog
+	int fogLoc = glGetUniformLocation(shaderProgram, "fog");
 
+	// load data into uniforms
+	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, *model);
+	glUniformMatrix4fv(viewLoc, 1, GL_FALSE, *view);
+	glUniformMatrix4fv(projLoc, 1, GL_FALSE, *proj);
 
-			// vertex attributes
-			
-			// position
-			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-			glEnableVertexAttribArray(0);
+	// load the chunk positions/offsets into corresponding uniform array
+	glUniform2fv(posLoc, glm_imin(offsetCount, MAX_CHUNK_SLOTS), offsets[0]);
 
-			// color
-			glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-			glEnableVertexAttribArray(1);
+	// pass underWaterLevel boolean in the form of an integer to fragment shader
+	if(underWaterLevel && drawingWater) {
+		glUniform1i(uwLoc, 1);
+	}
+	else {
+		glUniform1i(uwLoc, 0);
+	}
 
-			// texture coords
-			glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-			glEnableVertexAttribArray(2);
+	// pass block shading uniform to fragment shader
+	glUniform1f(shadingLoc, shading);
 
-			// now unbind everything
-			glBindVertexArray(0);
-			glBindBuffer(GL_ARRAY_BUFFER, 0);
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	// pass tide level to vertex shader based on whether its a water chunk or not
+	if(water) {
+		glUniform1f(tideLoc, get_tide_level());
+	}
+	else {
+		glUniform1f(tideLoc, 0);
+	}
 
-		}
+	// pass camera position as uniform vector3 to fragment shader
+	glUniform3f(camPosLoc, (*camPos)[0], (*camPos)[1], (*camPos)[2]);
 
-		// back block
+	// pass showFog boolean as uniform int to fragment shader
+	glUniform1i(fogLoc, showFog);
 
-		// back position vector
-		vec3 backPos;
-		glm_vec3_copy((vec3){block[0], block[1], block[2]+1}, backPos);
+}
 
-		// if back block position leaks into the side of the other chunk AND the chunk exists AND the block in that chunk isnt an air block (in this exact order)
-		if( backPos[2] == CHUNK_LENGTH && bottomChunk != NULL && get_block_type((*bottomChunk).blockTypes, backPos[0], backPos[1], 0) != 0 ) {
+// sets up the texture units and block tile table of the vertex pulling shader, which never change
+void init_pull_shader(unsigned int shaderProgram) {
 
-			// bind vao
-			glBindVertexArray((*bottomChunk).mesh.vao);
+	uint32_t blockTiles[BLOCK_TILE_TABLE_SIZE];
+	create_block_tile_table(blockTiles);
 
-			// bind vbo and ebo
-			glBindBuffer(GL_ARRAY_BUFFER, (*bottomChunk).mesh.vbo);
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (*bottomChunk).mesh.ebo);
+	// use shader program
+	glUseProgram(shaderProgram);
 
+	// the atlas stays on texture unit 0, the face records and their slots go on 1 and 2 (see bind_face_arena)
+	glUniform1i(glGetUniformLocation(shaderProgram, "inTexture"), 0);
+	glUniform1i(glGetUniformLocation(shaderProgram, "faceRecords"), 1);
+	glUniform1i(glGetUniformLocation(shaderProgram, "faceSlots"), 2);
 
-			// ---
+	// load the texture of every side of every block type into the corresponding uniform array
+	glUniform1uiv(glGetUniformLocation(shaderProgram, "blockTiles"), BLOCK_TILE_TABLE_SIZE, blockTiles);
 
+}
 
-			// get block type in the form of integer
-			int blockType = get_block_type((*bottomChunk).blockTypes, backPos[0], backPos[1], 0);
+// draws a chunk on its own, the water, whose slots are the chunks it covers (offset by its position, as it follows the camera around)
+void draw_chunk(struct Chunk chunk, unsigned int shaderProgram, unsigned int worldAtlas, bool water, bool drawingWater) {
 
-			// get index of block
-			int blockIndex = get_block_index((*bottomChunk).blockTypes, backPos[0], backPos[1], 0);
+	vec2 offsets[MAX_CHUNK_SLOTS];
 
-			// define type string based on returned block type
-			type = int_to_string_block_type(blockType);
+	for(int slot = 0; slot < waterSize*waterSize && slot < MAX_CHUNK_SLOTS; slot++) {
+		offsets[slot][0] = (chunk.pos[0] + slot % waterSize) * CHUNK_WIDTH;
+		offsets[slot][1] = (chunk.pos[1] + slot / waterSize) * CHUNK_LENGTH;
+	}
 
+	use_chunk_shader(shaderProgram, worldAtlas, offsets, waterSize*waterSize, water, drawingWater);
 
-			// generate proper vertices array and load it into sideVertices
-			create_side_vertices("back", type, backPos[0], backPos[1], 0, sideVertices);
-			
-			// generate proper indices array and load it into sideIndices
-			create_side_indices( 1*(4) , blockIndex, sideIndices);
+	// draw the elements
+	bind_mesh_arena();
 
-			// load proper vertices and indices array into VBO via glBufferSubData
-			glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * blockIndex + 1*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * blockIndex + 1*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
+	draw_arena_mesh(&chunk.meshes[0]);
 
-			// increment amount of sides
-			(*bottomChunk).sides += 6;
+}
 
-			
-			// ---
+// draws count chunks out of the chunkCount loaded chunks with a single draw call, the slots are the loaded chunks
+// (or two, while meshes that are vertices and meshes that are face records are both around, the latter are drawn with the
+// vertex pulling shader)
+void draw_chunks(struct Chunk* chunks, int chunkCount, int* indices, int count, unsigned int shaderProgram, unsigned int pullShaderProgram, unsigned int worldAtlas, bool drawingWater) {
 
+	vec2 offsets[MAX_CHUNK_SLOTS];
 
-			// vertex attributes
-			
-			// position
-			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-			glEnableVertexAttribArray(0);
+	for(int slot = 0; slot < chunkCount && slot < MAX_CHUNK_SLOTS; slot++) {
+		offsets[slot][0] = chunks[slot].pos[0]*CHUNK_WIDTH;
+		offsets[slot][1] = chunks[slot].pos[1]*CHUNK_LENGTH;
+	}
 
-			// color
-			glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-			glEnableVertexAttribArray(1);
+	use_chunk_shader(shaderProgram, worldAtlas, offsets, chunkCount, false, drawingWater);
 
-			// texture coords
-			glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-			glEnableVertexAttribArray(2);
+	// every section of the chunks has a mesh of its own (count can be 0, so this isn't sized by it, there are never more chunks
+	// than slots, see init_world)
+	int meshCount = count * CHUNK_SECTIONS;
 
-			// now unbind everything
-			glBindVertexArray(0);
-			glBindBuffer(GL_ARRAY_BUFFER, 0);
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	struct ArenaMesh* meshes[MAX_CHUNK_SLOTS * CHUNK_SECTIONS];
 
+	for(int i = 0; i < count; i++) {
+		for(int section = 0; section < CHUNK_SECTIONS; section++) {
+			meshes[i*CHUNK_SECTIONS + section] = &chunks[indices[i]].meshes[section];
 		}
+	}
 
-		// left block
-
-		// left position vector
-		vec3 leftPos;
-		glm_vec3_copy((vec3){block[0]-1, block[1], block[2]}, leftPos);
-
-		// if left block position leaks into the side of the other chunk AND the chunk exists AND the block in that chunk isnt an air block (in this exact order)
-		if( leftPos[0] == -1 && leftChunk != NULL && get_block_type((*leftChunk).blockTypes, CHUNK_WIDTH-1, leftPos[1], leftPos[2]) != 0 ) {
-
-			// bind vao
-			glBindVertexArray((*leftChunk).mesh.vao);
-
-			// bind vbo and ebo
-			glBindBuffer(GL_ARRAY_BUFFER, (*leftChunk).mesh.vbo);
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (*leftChunk).mesh.ebo);
-
+	// draw the elements
+	bind_mesh_arena();
 
-			// ---
+	draw_arena_meshes(meshes, meshCount);
 
+	// and the face records
+	use_chunk_shader(pullShaderProgram, worldAtlas, offsets, chunkCount, false, drawingWater);
 
-			// get block type in the form of integer
-			int blockType = get_block_type((*leftChunk).blockTypes, CHUNK_WIDTH-1, leftPos[1], leftPos[2]);
+	bind_face_arena();
 
-			// get index of block
-			int blockIndex = get_block_index((*leftChunk).blockTypes, CHUNK_WIDTH-1, leftPos[1], leftPos[2]);
-
-			// define type string based on returned block type
-			type = int_to_string_block_type(blockType);
-
-
-			// generate proper vertices array and load it into sideVertices
-			create_side_vertices("right", type, CHUNK_WIDTH-1, leftPos[1], leftPos[2], sideVertices);
-			
-			// generate proper indices array and load it into sideIndices
-			create_side_indices( 2*(4) , blockIndex, sideIndices);
-
-			// load proper vertices and indices array into VBO via glBufferSubData
-			glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * blockIndex + 2*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * blockIndex + 2*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
-
-			// increment amount of sides
-			(*leftChunk).sides += 6;
-
-			
-			// ---
-
-
-			// vertex attributes
-			
-			// position
-			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-			glEnableVertexAttribArray(0);
-
-			// color
-			glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-			glEnableVertexAttribArray(1);
-
-			// texture coords
-			glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-			glEnableVertexAttribArray(2);
-
-			// now unbind everything
-			glBindVertexArray(0);
-			glBindBuffer(GL_ARRAY_BUFFER, 0);
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-		}
-
-		// right block
-
-		// right position vector
-		vec3 rightPos;
-		glm_vec3_copy((vec3){block[0]+1, block[1], block[2]}, rightPos);
-
-		// if right block position leaks into the side of the other chunk AND the chunk exists AND the block in that chunk isnt an air block (in this exact order)
-		if( rightPos[0] == CHUNK_WIDTH && rightChunk != NULL && get_block_type((*rightChunk).blockTypes, 0, rightPos[1], rightPos[2]) != 0 ) {
-
-			// bind vao
-			glBindVertexArray((*rightChunk).mesh.vao);
-
-			// bind vbo and ebo
-			glBindBuffer(GL_ARRAY_BUFFER, (*rightChunk).mesh.vbo);
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (*rightChunk).mesh.ebo);
-
-
-			// ---
-
-
-			// get block type in the form of integer
-			int blockType = get_block_type((*rightChunk).blockTypes, 0, rightPos[1], rightPos[2]);
-
-			// get index of block
-			int blockIndex = get_block_index((*rightChunk).blockTypes, 0, rightPos[1], rightPos[2]);
-
-			// define type string based on returned block type
-			type = int_to_string_block_type(blockType);
-
-
-			// generate proper vertices array and load it into sideVertices
-			create_side_vertices("left", type, 0, rightPos[1], rightPos[2], sideVertices);
-			
-			// generate proper indices array and load it into sideIndices
-			create_side_indices( 3*(4) , blockIndex, sideIndices);
-
-			// load proper vertices and indices array into VBO via glBufferSubData
-			glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * blockIndex + 3*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * blockIndex + 3*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
-
-			// increment amount of sides
-			(*rightChunk).sides += 6;
-
-			
-			// ---
-
-
-			// vertex attributes
-			
-			// position
-			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-			glEnableVertexAttribArray(0);
-
-			// color
-			glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-			glEnableVertexAttribArray(1);
-
-			// texture coords
-			glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-			glEnableVertexAttribArray(2);
-
-			// now unbind everything
-			glBindVertexArray(0);
-			glBindBuffer(GL_ARRAY_BUFFER, 0);
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-		}
-
-
-	}
-
-}
-
-
-// ---
-
-
-struct Chunk generate_chunk(vec2 position, int world_size, bool water) {
-
-	// create new chunk structure instance
-	struct Chunk newChunk;
-
-	// allocate integer amount of maximum blocks possible in a chunk
-	int blockAmount = CHUNK_WIDTH*CHUNK_HEIGHT*CHUNK_LENGTH;
-
-	// if water then change the value of block amount
-	if(water) {
-		blockAmount = CHUNK_WIDTH*CHUNK_HEIGHT * world_size*world_size;
-	}
-
-	// x and y pos for placing blocks
-	int xPos = 0;
-	int yPos = 0;
-	int zPos = 0;
-
-	// allocate memory to block amount to be used as an array
-	newChunk.blockTypes = calloc(blockAmount, sizeof(int));
-
-	// set sides to 0
-	newChunk.sides = 0;
-
-	
-	// ---
-	
-
-	// create vbo
-	unsigned int VBO;
-	glGenBuffers(1, &VBO);
-
-	// bind vbo
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * (6*4*8 * blockAmount), 0, GL_STATIC_DRAW);
-
-
-	// ---
-	
-
-	// create ebo
-	unsigned int EBO;
-	glGenBuffers(1, &EBO);
-
-	// bind ebo
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(int) * (6*6 * blockAmount), 0, GL_STATIC_DRAW);
-
-
-	// ---
-
-
-	// if its not a water chunk
-	if(!water) {
-
-
-		int noiseValue = 0;
-
-		// first iteration, load all coordinates of blocks, as this allows for later optimization
-		for(int i=0; i < blockAmount; i++) {
-
-			// calculate noise value
-
-
-			noiseValue = calc_chunk_noise_value((vec2){xPos, zPos}, position);
-			
-			// cap noise value to chunk height
-			if(noiseValue >= CHUNK_HEIGHT) {
-				noiseValue = CHUNK_HEIGHT-1;
-			}
-
-			// based on noise value, fill with blocks or air
-			if(yPos > CHUNK_HEIGHT-STONE_LEVEL && yPos <= noiseValue) {
-				newChunk.blockTypes[i] = 3; // stone
-			}
-			else if(yPos <= SAND_LEVEL && yPos <= noiseValue) {
-				newChunk.blockTypes[i] = 4; // sand
-			}
-			else if(yPos == noiseValue+1 
-					&& yPos < CHUNK_HEIGHT-STONE_LEVEL-TREE_BUFFER_LEVEL && yPos > SAND_LEVEL+1
-					&& xPos > 0 && xPos < CHUNK_WIDTH-1
-					&& zPos > 0 && zPos < CHUNK_LENGTH-1) {
-				// tree generation
-
-				// random value in between 0-1, determines if a tree will be placed
-				float randomValue = (float)rand() / RAND_MAX;
-
-				// if value is less than the chance to spawn a tree
-				if(randomValue < CHANCE_OF_TREE) {
-					newChunk.blockTypes[i] = 5; // first log block, later used to generate the trees
-				}
-				else {
-					newChunk.blockTypes[i] = 0; // air
-				}
-			}
-			else if(yPos == noiseValue) {
-				newChunk.blockTypes[i] = 1; // grass
-			}
-			else if(yPos < noiseValue) {
-				newChunk.blockTypes[i] = 2; // dirt
-			}
-			else {
-				newChunk.blockTypes[i] = 0; // air
-			}
-
-			// if bottom most layer, then fill it in automatically
-			if(yPos == 0) {
-				newChunk.blockTypes[i] = 4; // sand
-			}
-			
-
-			// ---
-
-
-			xPos++;
-		
-			// if x position exceeds 16th block then reset it and increment z position
-			if(xPos >= CHUNK_WIDTH) {
-				zPos++;
-				xPos = 0;
-			}
-
-			// if z position exceeds 16th block then reset it (as well as x) and increment y position
-			if(zPos >= CHUNK_LENGTH) {
-				yPos++;
-				zPos = 0;
-				xPos = 0;
-			}
-
-		}
-
-
-		// ---
-		
-
-		// reset positions
-		xPos = 0;
-		yPos = 0;
-		zPos = 0;
-
-		
-		// ---
-		
-
-		// another for loop, find all the start blocks for trees and expand on them
-		for(int i=0; i < blockAmount; i++) {
-
-			// if the block is a wood log and the block below it is grass (meaning its the first log block of the tree)
-			if(newChunk.blockTypes[i] == 5 && get_block_type(newChunk.blockTypes, xPos, yPos-1, zPos) == 1) {
-
-				// get amount of log blocks to expand upon for blocks (remove 1 cus we already start with one)
-				int logAmount = ( (float)rand() / (float)(RAND_MAX) ) * (MAX_TREE_HEIGHT-MIN_TREE_HEIGHT) + MIN_TREE_HEIGHT - 1;
-
-				// if indexed y position is below half of the stone level (trying to prevent segfaults by indexing out of blockTypes)
-				if(yPos+logAmount > CHUNK_HEIGHT-STONE_LEVEL) {
-					// cap logAmount at that value
-					logAmount = CHUNK_HEIGHT-STONE_LEVEL - yPos;
-				}
-
-				// iterate thru log amount
-				for(int l=0; l < logAmount; l++) {
-
-					// get index of log block
-					int logIndex = get_block_index(newChunk.blockTypes, xPos, yPos+l, zPos);
-
-					// set that indexed block to a log block
-					newChunk.blockTypes[logIndex] = 5;
-
-				}
-
-				
-				// ---
-
-
-				// now leaves blocks
-
-				// top (100% spawn)
-				newChunk.blockTypes[get_block_index(newChunk.blockTypes, xPos, yPos+logAmount, zPos)] = 6;
-
-				// left (100% spawn)
-				newChunk.blockTypes[get_block_index(newChunk.blockTypes, xPos-1, yPos+logAmount-1, zPos)] = 6;
-
-				// right (100% spawn)
-				newChunk.blockTypes[get_block_index(newChunk.blockTypes, xPos+1, yPos+logAmount-1, zPos)] = 6;
-
-				// back (100% spawn)
-				newChunk.blockTypes[get_block_index(newChunk.blockTypes, xPos, yPos+logAmount-1, zPos-1)] = 6;
-
-				// front (100% spawn)
-				newChunk.blockTypes[get_block_index(newChunk.blockTypes, xPos, yPos+logAmount-1, zPos+1)] = 6;
-
-				// random amount of extra blocks (12 extra spots if u count it)
-				int extraLeaves = (int)( ((float)rand() / (float)RAND_MAX) * 12 );
-
-				for(int l=0; l < extraLeaves; l++) {
-					// x can be from -1 - 1
-					int x =  floor( ((float)rand() / (float)RAND_MAX) * 3  - 1);
-
-					// y can be either 0 or 1
-					int y =  floor( ((float)rand() / (float)RAND_MAX) * 2 );
-
-					// z can be from -1 - 1
-					int z =  floor( ((float)rand() / (float)RAND_MAX) * 3  - 1);
-
-					// insert this new leaves block
-					newChunk.blockTypes[get_block_index(newChunk.blockTypes, xPos+x, yPos+logAmount-1+y, zPos+z)] = 6;
-
-				}
-
-			}
-
-			// ---
-
-
-			xPos++;
-		
-			// if x position exceeds 16th block then reset it and increment z position
-			if(xPos >= CHUNK_WIDTH) {
-				zPos++;
-				xPos = 0;
-			}
-
-			// if z position exceeds 16th block then reset it (as well as x) and increment y position
-			if(zPos >= CHUNK_LENGTH) {
-				yPos++;
-				zPos = 0;
-				xPos = 0;
-			}
-
-		}
-
-		// ---
-		
-
-		// reset positions
-		xPos = 0;
-		yPos = 0;
-		zPos = 0;
-
-
-		// ---
-		
-
-		// define side vertices arrays for each side of a block
-		float frontVertices  [4*8];
-		float backVertices   [4*8];
-		float leftVertices   [4*8];
-		float rightVertices  [4*8];
-		float bottomVertices [4*8];
-		float topVertices    [4*8];
-
-		// create single side indices array
-		int sideIndices[6];
-
-		// now iterate (again) thru all block positions
-		for(int i=0; i < blockAmount; i++) {
-
-			// add on vertices index
-			int verticesIndex = 0;
-
-			int indicesIndex = 0;
-			int indicesOffset = 0;
-
-
-			// ---
-		
-
-			// booleans to tell whether to add those sides or not
-			bool front  = true;
-			bool back   = true;
-			bool left   = true;
-			bool right  = true;
-			bool bottom = true;
-			bool top    = true;
-
-			// set all to false if block type is 0 (air)
-			if(get_block_type(newChunk.blockTypes, xPos, yPos, zPos) == 0) {
-				front  = false;
-				back   = false;
-				left   = false;
-				right  = false;
-				bottom = false;
-				top    = false;
-			}
-					
-			// front
-			if( zPos != CHUNK_LENGTH-1 && get_block_type(newChunk.blockTypes, xPos, yPos, zPos+1) > 0 ) {
-				front = false;
-			}
-			// back
-			if( zPos != 0 && get_block_type(newChunk.blockTypes, xPos, yPos, zPos-1) > 0 ) {
-				back = false;
-			}
-			// left
-			if( xPos != 0 && get_block_type(newChunk.blockTypes, xPos-1, yPos, zPos) > 0 ) {
-				left = false;
-			}
-			// right
-			if( xPos != CHUNK_WIDTH-1 && get_block_type(newChunk.blockTypes, xPos+1, yPos, zPos) > 0 ) {
-				right = false;
-			}
-			// bottom (remove bottom face if it is the bottom-most block too)
-			if( (yPos != 0 && get_block_type(newChunk.blockTypes, xPos, yPos-1, zPos) > 0)
-					|| yPos == 0) {
-				bottom = false;
-			}
-			// top
-			if( yPos != CHUNK_HEIGHT-1 && get_block_type(newChunk.blockTypes, xPos, yPos+1, zPos) > 0 ) {
-				top = false;
-			}
-
-			// declare type string
-			const char* type;
-
-			// get string counterpart from int format of block type
-			type = int_to_string_block_type(
-					get_block_type(newChunk.blockTypes, xPos, yPos, zPos)
-			);
-
-
-			// only load vertices and indices for necessary sides
-			
-
-			if(front) {
-				// generate proper vertices array and load it into frontVertices
-				create_side_vertices("front", type, xPos, yPos, zPos, frontVertices);
-				
-				// generate proper indices array and load it into sideIndices
-				create_side_indices(indicesOffset, i, sideIndices);
-
-				// load proper vertices and indices array into VBO via glBufferSubData
-				glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + 0*(4*8 * sizeof(float)), sizeof(frontVertices), frontVertices);
-				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + 0*(6 * sizeof(int)), sizeof(sideIndices), sideIndices);
-			}
-			// increment vertices and indices index, as well as indices offset
-			verticesIndex += 4*8 * sizeof(float);
-			indicesIndex += 6 * sizeof(int);
-			indicesOffset += 4;
-
-			// increment amount of sides
-			newChunk.sides += 6;
-
-			if(back) {
-				// generate proper vertices array and load it into backVertices
-				create_side_vertices("back", type, xPos, yPos, zPos, backVertices);
-
-				// generate proper indices array and load it into sideIndices
-				create_side_indices(indicesOffset, i, sideIndices);
-
-				// load proper vertices and indices array into VBO via glBufferSubData
-				glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + 1*(4*8 * sizeof(float)), sizeof(backVertices), backVertices);
-				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + 1*(6 * sizeof(int)), sizeof(sideIndices), sideIndices);
-
-				// increment amount of sides
-				newChunk.sides += 6;
-			}
-			// increment vertices and indices index, as well as indices offset
-			verticesIndex += 4*8 * sizeof(float);
-			indicesIndex += 6 * sizeof(int);
-			indicesOffset += 4;
-
-			if(left) {
-				// generate proper vertices array and load it into leftVertices
-				create_side_vertices("left", type,  xPos, yPos, zPos, leftVertices);
-
-				// generate proper indices array and load it into sideIndices
-				create_side_indices(indicesOffset, i, sideIndices);
-
-				// load proper vertices and indices array into VBO via glBufferSubData
-				glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + 2*(4*8 * sizeof(float)), sizeof(leftVertices), leftVertices);
-				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + 2*(6 * sizeof(int)), sizeof(sideIndices), sideIndices);
-
-				// increment amount of sides
-				newChunk.sides += 6;
-			}
-			// increment vertices and indices index, as well as indices offset
-			verticesIndex += 4*8 * sizeof(float);
-			indicesIndex += 6 * sizeof(int);
-			indicesOffset += 4;
-
-			if(right) {
-				// generate proper vertices array and load it into rightVertices
-				create_side_vertices("right", type, xPos, yPos, zPos, rightVertices);
-
-				// generate proper indices array and load it into sideIndices
-				create_side_indices(indicesOffset, i, sideIndices);
-
-				// load proper vertices and indices array into VBO via glBufferSubData
-				glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + 3*(4*8 * sizeof(float)), sizeof(rightVertices), rightVertices);
-				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + 3*(6 * sizeof(int)), sizeof(sideIndices), sideIndices);
-
-				// increment amount of sides
-				newChunk.sides += 6;
-			}
-			// increment vertices and indices index, as well as indices offset
-			verticesIndex += 4*8 * sizeof(float);
-			indicesIndex += 6 * sizeof(int);
-			indicesOffset += 4;
-
-			if(bottom && strcmp(type, "water") != 0) {
-				// generate proper vertices array and load it into bottomVertices
-				create_side_vertices("bottom", type, xPos, yPos, zPos, bottomVertices);
-
-				// generate proper indices array and load it into sideIndices
-				create_side_indices(indicesOffset, i, sideIndices);
-
-				// load proper vertices and indices array into VBO via glBufferSubData
-				glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + 4*(4*8 * sizeof(float)), sizeof(bottomVertices), bottomVertices);
-				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + 4*(6 * sizeof(int)), sizeof(sideIndices), sideIndices);
-
-				// increment amount of sides
-				newChunk.sides += 6;
-			}
-			// increment vertices and indices index, as well as indices offset
-			verticesIndex += 4*8 * sizeof(float);
-			indicesIndex += 6 * sizeof(int);
-			indicesOffset += 4;
-
-			if(top) {
-				// generate proper vertices array and load it into topVertices
-				create_side_vertices("top", type, xPos, yPos, zPos, topVertices);
-
-				// generate proper indices array and load it into sideIndices
-				create_side_indices(indicesOffset, i, sideIndices);
-
-				// load proper vertices and indices array into VBO via glBufferSubData
-				glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + 5*(4*8 * sizeof(float)), sizeof(topVertices), topVertices);
-				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + 5*(6 * sizeof(int)), sizeof(sideIndices), sideIndices);
-
-				// increment amount of sides
-				newChunk.sides += 6;
-			}
-
-
-			// ---
-
-
-			xPos++;
-		
-			// if x position exceeds 16th block then reset it and increment z position
-			if(xPos >= CHUNK_WIDTH) {
-				zPos++;
-				xPos = 0;
-			}
-
-			// if z position exceeds 16th block then reset it (as well as x) and increment y position
-			if(zPos >= CHUNK_LENGTH) {
-				yPos++;
-				zPos = 0;
-				xPos = 0;
-			}
-
-		}
-
-
-	}
-	else { // if its a water chunk
-
-		// chunk x and y position
-		int chunkX = 0;
-		int chunkY = 0;
-
-		// create single side indices array
-		//int sideIndices[6];
-
-		// top vertices array
-		float topVertices[4*8];
-
-		// offset for indices
-		int indicesOffset = 0;
-
-		// x y z values for water face
-		int x = 0;
-		int y = SAND_LEVEL-1;
-		int z = 0;
-
-		// iterate through all water blocks/faces thingies in the world
-		for(int b=0; b < CHUNK_LENGTH*CHUNK_WIDTH*world_size*world_size; b++) {
-
-
-			// generate proper vertices array and load it into topVertices
-			create_side_vertices("top", "water", x, y, z, topVertices);
-
-			// generate custom indices array
-			int sideIndices[] = {
-				indicesOffset, indicesOffset+1, indicesOffset+2,
-				indicesOffset+1, indicesOffset+2, indicesOffset+3,
-			};
-
-			// load proper vertices and indices array into VBO via glBufferSubData
-			glBufferSubData(GL_ARRAY_BUFFER, 
-					b * ( sizeof(float) * 4*8 ), 
-					sizeof(topVertices), topVertices);
-
-			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 
-					b * ( sizeof(int) * 6 ),
-					sizeof(sideIndices), sideIndices);
-
-			// increment amount of sides
-			newChunk.sides += 6;
-
-			// increment indices offset
-			indicesOffset += 4;
-
-
-			// ---
-
-			
-			// position handling
-
-			x++;
-
-			if(x >= world_size*CHUNK_WIDTH) {
-				x = 0;
-				z++;
-			}
-
-		}
-
-
-
-
-	}
-	
-
-	// unbind vbo and ebo
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-
-	// ---
-	
-
-	// create vao
-	unsigned int VAO;
-	glGenVertexArrays(1, &VAO);
-
-	// bind vao
-	glBindVertexArray(VAO);
-
-	// bind vbo and ebo
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-
-	// vertex attributes
-	
-	// position
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
-
-	// color
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-	glEnableVertexAttribArray(1);
-
-	// texture coords
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-	glEnableVertexAttribArray(2);
-
-	// unbind vao
-	glBindVertexArray(0);
-
-	// unbind vbo and ebo
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-
-	// ---
-	
-
-	// create chunk mesh object
-	struct Mesh chunkMesh;
-
-	// assign vao, vbo, and ebo to mesh
-	chunkMesh.vao = VAO;
-	chunkMesh.vbo = VBO;
-	chunkMesh.ebo = EBO;
-
-	// apply mesh to chunk object
-	newChunk.mesh = chunkMesh;
-
-	// apply position to chunk object
-	glm_vec2_copy(position, newChunk.pos);
-
-	// return newly generated chunk object
-	return newChunk;
-
-}
-
-
-// ---
-
-
-// optimize the chunks to remove internal faces
-void handle_chunk_sides(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk) {
-
-	// bind vao
-	glBindVertexArray((*chunk).mesh.vao);
-
-	// bind vbo and ebo
-	glBindBuffer(GL_ARRAY_BUFFER, (*chunk).mesh.vbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (*chunk).mesh.ebo);
-
-	// create empty vertices array for that side
-	float sideVertices[4*8];
-
-	// create empty indices array for that side
-	float sideIndices[6];
-
-	// check left chunk, main chunk x = 0, left chunk x = CHUNK_WIDTH-1
-
-	// if passed left chunk is not NULL
-	if(leftChunk != NULL) {
-		// iterate thru z and y
-		for(int z = 0; z < CHUNK_LENGTH; z++) {
-
-			for(int y = 0; y < CHUNK_HEIGHT; y++) {
-			
-				// get type of corresponding block in main chunk on its left side
-				int mainBlockType = get_block_type((*chunk).blockTypes, 0, y, z);
-
-				// get type of corresponding block in left chunk on its right side (so to the left of the indexed main block)
-				int leftBlockType = get_block_type((*leftChunk).blockTypes, CHUNK_WIDTH-1, y, z);
-
-				// if the block on the left isn't air and main block also isn't air
-				if(leftBlockType != 0 && mainBlockType != 0) {
-
-					// we want to remove that side from the buffer for now
-					
-					// get the index of that block
-					int i = get_block_index((*chunk).blockTypes, 0, y, z);
-
-					// load proper vertices and indices array into VBO via glBufferSubData
-					glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + 2*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-					glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + 2*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
-				}
-
-			}
-
-		}
-	}
-	// otherwise just remove the whole side facing edge of world
-	else {
-		// iterate thru z and y
-		for(int z = 0; z < CHUNK_LENGTH; z++) {
-
-			for(int y = 0; y < CHUNK_HEIGHT; y++) {
-				
-				// get the index of that block
-				int i = get_block_index((*chunk).blockTypes, 0, y, z);
-
-				// load proper vertices and indices array into VBO via glBufferSubData
-				glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + 2*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + 2*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
-
-			}
-
-		}
-	}
-
-
-	// ---
-	
-
-	// check right chunk, main chunk x = CHUNK_WIDTH-1, right chunk x = 0
-	
-	// if passed right chunk is not NULL
-	if(rightChunk != NULL) {
-		// iterate thru z and y
-		for(int z = 0; z < CHUNK_LENGTH; z++) {
-
-			for(int y = 0; y < CHUNK_HEIGHT; y++) {
-			
-				// get type of corresponding block in main chunk on its right side
-				int mainBlockType = get_block_type((*chunk).blockTypes, CHUNK_WIDTH-1, y, z);
-
-				// get type of corresponding block in right chunk on its left side (so to the right of the indexed main block)
-				int rightBlockType = get_block_type((*rightChunk).blockTypes, 0, y, z);
-
-				// if the block on the right isn't air and main block also isn't air
-				if(rightBlockType != 0 && mainBlockType != 0) {
-
-					// we want to remove that side from the buffer for now
-					
-					// get the index of that block
-					int i = get_block_index((*chunk).blockTypes, CHUNK_WIDTH-1, y, z);
-
-					// load proper vertices and indices array into VBO via glBufferSubData
-					glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + 3*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-					glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + 3*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
-
-				}
-
-			}
-
-		}
-	}
-	// otherwise just remove the whole side facing edge of world
-	else {
-		// iterate thru z and y
-		for(int z = 0; z < CHUNK_LENGTH; z++) {
-
-			for(int y = 0; y < CHUNK_HEIGHT; y++) {
-				
-				// get the index of that block
-				int i = get_block_index((*chunk).blockTypes, CHUNK_WIDTH-1, y, z);
-
-				// load proper vertices and indices array into VBO via glBufferSubData
-				glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + 3*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + 3*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
-
-			}
-
-		}
-	}
-
-
-	// ---
-	
-
-	// check top chunk, main chunk z = 0, top chunk z = CHUNK_LENGTH-1
-
-	// if passed top chunk is not NULL
-	if(topChunk != NULL) {
-		// iterate thru z and y
-		for(int x = 0; x < CHUNK_WIDTH; x++) {
-
-			for(int y = 0; y < CHUNK_HEIGHT; y++) {
-			
-				// get type of corresponding block in main chunk on its top side
-				int mainBlockType = get_block_type((*chunk).blockTypes, x, y, CHUNK_LENGTH-1);
-
-				// get type of corresponding block in top chunk on its bottom (front) side (so behind the indexed main block)
-				int topBlockType = get_block_type((*topChunk).blockTypes, x, y, 0);
-
-				// if the block at top (back) isn't air and main block also isn't air
-				if(topBlockType != 0 && mainBlockType != 0) {
-
-					// we want to remove that side from the buffer for now
-					
-					// get the index of that block
-					int i = get_block_index((*chunk).blockTypes, x, y, CHUNK_LENGTH-1);
-
-					// load proper vertices and indices array into VBO via glBufferSubData
-					glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + 0*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-					glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + 0*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
-
-				}
-
-			}
-
-		}
-	}
-	// otherwise just remove the whole side facing edge of world
-	else {
-		// iterate thru z and y
-		for(int x = 0; x < CHUNK_WIDTH; x++) {
-
-			for(int y = 0; y < CHUNK_HEIGHT; y++) {
-				
-				// get the index of that block
-				int i = get_block_index((*chunk).blockTypes, x, y, CHUNK_LENGTH-1);
-
-				// load proper vertices and indices array into VBO via glBufferSubData
-				glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + 0*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + 0*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
-
-			}
-
-		}
-	}
-
-
-	// ---
-	
-	
-	// check bottom chunk, main chunk z = CHUNK_LENGTH-1, bottom chunk z = 0
-
-	// if passed bottom chunk is not NULL
-	if(bottomChunk != NULL) {
-		// iterate thru z and y
-		for(int x = 0; x < CHUNK_WIDTH; x++) {
-
-			for(int y = 0; y < CHUNK_HEIGHT; y++) {
-			
-				// get type of corresponding block in main chunk on its bottom side
-				int mainBlockType = get_block_type((*chunk).blockTypes, x, y, 0);
-
-				// get type of corresponding block in bottom chunk on its top (back) side (so in front of the indexed main block)
-				int bottomBlockType = get_block_type((*bottomChunk).blockTypes, x, y, CHUNK_LENGTH-1);
-
-				// if the block at bottom (front) isn't air and main block also isn't air
-				if(bottomBlockType != 0 && mainBlockType != 0) {
-
-					// we want to remove that side from the buffer for now
-					
-					// get the index of that block
-					int i = get_block_index((*chunk).blockTypes, x, y, 0);
-
-					// load proper vertices and indices array into VBO via glBufferSubData
-					glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + 1*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-					glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + 1*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
-
-				}
-
-			}
-
-		}
-	}
-	// otherwise just remove the whole side facing edge of world
-	else {
-		// iterate thru z and y
-		for(int x = 0; x < CHUNK_WIDTH; x++) {
-
-			for(int y = 0; y < CHUNK_HEIGHT; y++) {
-				
-				// get the index of that block
-				int i = get_block_index((*chunk).blockTypes, x, y, 0);
-
-				// load proper vertices and indices array into VBO via glBufferSubData
-				glBufferSubData(GL_ARRAY_BUFFER, (sizeof(float) * 6*4*8) * i + 1*(4*8*sizeof(float)), sizeof(sideVertices), sideVertices);
-				glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (sizeof(int) * 6*6) * i + 1*(6*sizeof(int)), sizeof(sideIndices), sideIndices);
-
-			}
-
-		}
-	}
-
-
-	// ---
-
-
-	// unbind vbo and ebo
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-
-	// ---
-	
-
-	// bind vao
-	glBindVertexArray((*chunk).mesh.vao);
-
-	// bind vbo and ebo
-	glBindBuffer(GL_ARRAY_BUFFER, (*chunk).mesh.vbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (*chunk).mesh.ebo);
-
-	// vertex attributes
-	
-	// position
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
-
-	// color
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-	glEnableVertexAttribArray(1);
-
-	// texture coords
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-	glEnableVertexAttribArray(2);
-
-	// now unbind everything
-	glBindVertexArray(0);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-}
-
-
-// ---
-
-
-void draw_chunk(struct Chunk chunk, unsigned int shaderProgram, unsigned int worldAtlas, bool water, bool drawingWater) {
-
-	// bind vao
-	glBindVertexArray(chunk.mesh.vao);
-
-	// use shader program
-	glUseProgram(shaderProgram);
-
-	// bind texture
-	glBindTexture(GL_TEXTURE_2D, worldAtlas);
-
-	// get camera matrices
-	mat4* model = get_model();
-	mat4* view = get_view();
-	mat4* proj = get_projection();
-
-	// get camera position
-	vec3* camPos = get_camera_pos();
-
-	// get block shading
-	float shading = get_block_shading();
-
-	// get locations of uniform camera matrices
-	int modelLoc = glGetUniformLocation(shaderProgram, "model");
-	int viewLoc = glGetUniformLocation(shaderProgram, "view");
-	int projLoc = glGetUniformLocation(shaderProgram, "proj");
-
-	// get location of chunk offset uniform
-	int posLoc = glGetUniformLocation(shaderProgram, "chunkOffset");
-
-	// get location of underwater uniform
-	int uwLoc = glGetUniformLocation(shaderProgram, "underWater");
-
-	// get location of uniform shading float
-	int shadingLoc = glGetUniformLocation(shaderProgram, "shading");
-
-	// get location of uniform tide float
-	int tideLoc = glGetUniformLocation(shaderProgram, "tide");
-
-	// get location of camera position uniform vector
-	int camPosLoc = glGetUniformLocation(shaderProgram, "camPos");
-
-	// get location of uniform boolean for showing fog
-	int fogLoc = glGetUniformLocation(shaderProgram, "fog");
-
-	// load data into uniforms
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, *model);
-	glUniformMatrix4fv(viewLoc, 1, GL_FALSE, *view);
-	glUniformMatrix4fv(projLoc, 1, GL_FALSE, *proj);
-
-	// load chunk position/offset into corresponding uniform vector
-	glUniform2f(posLoc, chunk.pos[0]*CHUNK_WIDTH, chunk.pos[1]*CHUNK_LENGTH);
-
-	// pass underWaterLevel boolean in the form of an integer to fragment shader
-	if(underWaterLevel && drawingWater) {
-		glUniform1i(uwLoc, 1);
-	}
-	else {
-		glUniform1i(uwLoc, 0);
-	}
-
-	// pass block shading uniform to fragment shader
-	glUniform1f(shadingLoc, shading);
-
-	// pass tide level to vertex shader based on whether its a water chunk or not
-	if(water) {
-		glUniform1f(tideLoc, get_tide_level());
-	}
-	else {
-		glUniform1f(tideLoc, 0);
-	}
-
-	// pass camera position as uniform vector3 to vertex shader
-	glUniform3f(camPosLoc, (*camPos)[0], (*camPos)[1], (*camPos)[2]);
-
-	// pass showFog boolean as uniform int to vertex shader
-	glUniform1i(fogLoc, showFog);
-
-	// draw the elements
-	glDrawElements(GL_TRIANGLES, 36 * chunk.sides, GL_UNSIGNED_INT, 0);
+	draw_arena_meshes(meshes, meshCount);
 
 }
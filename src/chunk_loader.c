@@ -0,0 +1,599 @@
+#include "../include/CGLM/cglm.h"
+
+#include <stdlib.h>
+
+#include "headers/chunk.h"
+#include "headers/chunk_map.h"
+#include "headers/chunk_loader.h"
+#include "headers/terrain.h"
+#include "headers/block_writes.h"
+#include "headers/culling.h"
+#include "headers/mesher.h"
+#include "headers/mesh_builder.h"
+#include "headers/workers.h"
+
+// loads chunks in and out on the worker threads, doesn't touch opengl (finished meshes are handed to a mesh handler)
+
+
+// ---
+
+
+// array of chunks with land blocks, used as a toroidal buffer of ringSize x ringSize slots
+// (the chunk at chunk coordinates x, z always lives in slot [z mod ringSize][x mod ringSize])
+struct Chunk* chunks;
+
+// side length of the chunks buffer, in chunks
+int ringSize = 0;
+
+int chunkCount = 0;
+
+// whether the chunks stream around streamCentre, instead of being a fixed ringSize x ringSize grid
+bool streaming = false;
+
+// how many chunks are loaded in every direction around the centre when streaming
+int streamDistance = 0;
+
+// chunk coordinates that the loaded chunks are centred around when streaming
+int streamCentre[2] = { 0, 0 };
+
+// whether or not there are chunk slots that still need to be switched over to a new chunk
+bool streamingDirty = false;
+
+// looks up chunks in the array by their chunk coordinates
+struct ChunkMap chunkMap;
+
+// handles the meshes built by the workers
+ChunkMeshHandler chunkMeshHandler = NULL;
+
+// blocks that loaded chunks placed in other chunks (the parts of trees that spill over their borders), kept for as long as
+// the chunk that made them stays loaded, so they get placed again if the chunk they go into is unloaded and loaded back in
+// (main thread only)
+struct BlockWrites pendingWrites;
+
+// amount of chunk slots that have pending writes waiting to be placed in them
+int pendingWriteChunks = 0;
+
+
+// ---
+
+
+// gets a chunk based on the snapped chunks position
+struct Chunk* get_chunk(int xPos, int yPos) {
+	return chunk_map_get(&chunkMap, xPos, yPos); // NULL if there isn't one
+}
+
+// gets the index of a chunk based on the snapped chunks position
+int get_chunk_index(int xPos, int yPos) {
+	struct Chunk* chunk = get_chunk(xPos, yPos);
+
+	if(chunk != NULL) {
+		return chunk - chunks;
+	}
+	return 0; // by default return first chunk
+}
+
+// links a chunk up with the chunks surrounding it in the chunk map, both ways
+void link_chunk(struct Chunk* chunk) {
+	int x = (*chunk).pos[0];
+	int z = (*chunk).pos[1];
+
+	(*chunk).leftChunk   = get_chunk(x-1, z);
+	(*chunk).rightChunk  = get_chunk(x+1, z);
+	(*chunk).topChunk    = get_chunk(x,   z+1);
+	(*chunk).bottomChunk = get_chunk(x,   z-1);
+
+	if((*chunk).leftChunk != NULL) {
+		(*(*chunk).leftChunk).rightChunk = chunk;
+	}
+	if((*chunk).rightChunk != NULL) {
+		(*(*chunk).rightChunk).leftChunk = chunk;
+	}
+	if((*chunk).topChunk != NULL) {
+		(*(*chunk).topChunk).bottomChunk = chunk;
+	}
+	if((*chunk).bottomChunk != NULL) {
+		(*(*chunk).bottomChunk).topChunk = chunk;
+	}
+}
+
+
+// ---
+
+
+// states a chunk slot goes thru as its chunk is loaded in
+enum ChunkState {
+	CHUNK_EMPTY,      // nothing loaded yet
+	CHUNK_GENERATING, // blocks are being generated on a worker (not in the chunk map yet)
+	CHUNK_GENERATED,  // blocks are there, but no mesh has been handed over yet
+	CHUNK_READY       // mesh handed over, can be drawn
+};
+
+// bookkeeping of the work handed to the worker threads for a single chunk slot
+struct ChunkJob {
+	struct Chunk* chunk;
+
+	enum ChunkState state;
+
+	bool busy; // whether a job for the chunk is queued up or running
+	bool needsRemesh; // whether the chunk has to be meshed again once its current job is done
+
+	int readers; // amount of mesh jobs of surrounding chunks currently reading the chunk's blocks
+
+	struct Chunk* meshNeighbours[4]; // surrounding chunks the running mesh job reads from (left, right, top, bottom)
+
+	bool hasPendingWrites; // whether pending writes came in for the chunk after its generate job was started
+
+	struct BlockWrites incoming; // pending writes going into the chunk, placed by its generate job
+	struct BlockWrites arrived; // pending writes that came in after its generate job was started, placed by place_pending_writes
+	struct BlockWrites outgoing; // blocks the generate job placed in other chunks, added to the pending writes afterwards
+
+	struct MeshBuilder builder; // mesh built by the worker, handed to the mesh handler by the main thread
+};
+
+// one job per chunk slot
+struct ChunkJob* chunkJobs;
+
+
+// ---
+
+
+// gets the job bookkeeping of a chunk
+struct ChunkJob* get_chunk_job(struct Chunk* chunk) {
+	return &chunkJobs[chunk - chunks];
+}
+
+// whether or not a chunk's blocks are being used by a worker thread (in which case they must not be changed)
+bool is_chunk_in_use(struct Chunk* chunk) {
+	struct ChunkJob* job = get_chunk_job(chunk);
+
+	return (*job).busy || (*job).readers > 0;
+}
+
+// whether or not a chunk has been generated and meshed, and isn't being worked on
+bool is_chunk_ready(struct Chunk* chunk) {
+	return (*get_chunk_job(chunk)).state == CHUNK_READY && !is_chunk_in_use(chunk);
+}
+
+// whether or not given chunk coordinates are inside the area of loaded chunks
+bool is_chunk_in_range(int xPos, int yPos) {
+	if(streaming) {
+		return abs(xPos - streamCentre[0]) <= streamDistance && abs(yPos - streamCentre[1]) <= streamDistance;
+	}
+	return xPos >= 0 && xPos < ringSize && yPos >= 0 && yPos < ringSize;
+}
+
+// works out the chunk coordinates that belong in a slot of the chunks buffer
+void get_slot_chunk_pos(int slot, int* xPos, int* yPos) {
+	int slotX = slot % ringSize;
+	int slotY = slot / ringSize;
+
+	if(!streaming) {
+		*xPos = slotX;
+		*yPos = slotY;
+		return;
+	}
+
+	// the one coordinate within the loaded area that wraps around onto this slot
+	int minX = streamCentre[0] - streamDistance;
+	int minY = streamCentre[1] - streamDistance;
+
+	*xPos = minX + ( ((slotX - minX) % ringSize) + ringSize ) % ringSize;
+	*yPos = minY + ( ((slotY - minY) % ringSize) + ringSize ) % ringSize;
+}
+
+
+// ---
+
+
+// generates the blocks of the job's chunk, terrain first, then trees, then whatever surrounding chunks placed in it (worker thread)
+void generate_chunk_job(void* data) {
+	struct ChunkJob* job = data;
+	struct Chunk* chunk = (*job).chunk;
+
+	struct ChunkGenerator generator;
+
+	generate_chunk_terrain(chunk, &generator);
+	decorate_chunk(chunk, &generator, &(*job).outgoing);
+
+	apply_block_writes(&(*job).incoming, (*chunk).pos[0], (*chunk).pos[1], generator.blockTypes);
+
+	// pack the blocks into the chunk's sections
+	pack_chunk_blocks(chunk, generator.blockTypes);
+
+	// and work out which of its faces can be seen thru it, and what it hides
+	update_chunk_culling(chunk);
+}
+
+// builds the mesh of the job's chunk against its surrounding chunks (worker thread)
+void mesh_chunk_job(void* data) {
+	struct ChunkJob* job = data;
+
+	build_chunk_mesh((*job).chunk, (*job).meshNeighbours[0], (*job).meshNeighbours[1], (*job).meshNeighbours[2], (*job).meshNeighbours[3], &(*job).builder);
+}
+
+// queues up the chunk to be meshed on a worker, once it and all its surrounding chunks within the loaded area are generated (main thread)
+void try_mesh_chunk(struct Chunk* chunk);
+
+// hands the mesh built for the job's chunk to the mesh handler and frees it (main thread)
+void finish_mesh_chunk_job(void* data) {
+	struct ChunkJob* job = data;
+
+	if(chunkMeshHandler != NULL) {
+		// the job's index is the slot of its chunk
+		chunkMeshHandler((*job).chunk, job - chunkJobs, &(*job).builder);
+	}
+
+	free_mesh_builder(&(*job).builder);
+
+	// the surrounding chunks aren't being read from anymore
+	for(int i = 0; i < 4; i++) {
+		if((*job).meshNeighbours[i] != NULL) {
+			(*get_chunk_job((*job).meshNeighbours[i])).readers--;
+		}
+	}
+
+	(*job).state = CHUNK_READY;
+	(*job).busy = false;
+
+	// if something changed while meshing, go again
+	if((*job).needsRemesh) {
+		(*job).needsRemesh = false;
+
+		try_mesh_chunk((*job).chunk);
+	}
+}
+
+// gets the loaded (or loading) chunk at chunk coordinates, even if it isn't done generating yet, NULL if there isn't one
+struct Chunk* get_slot_chunk(int xPos, int yPos) {
+	if(!is_chunk_in_range(xPos, yPos)) {
+		return NULL;
+	}
+
+	// the slot the chunk would be in
+	int slot = ( (yPos % ringSize) + ringSize ) % ringSize * ringSize + ( (xPos % ringSize) + ringSize ) % ringSize;
+
+	if(chunkJobs[slot].state == CHUNK_EMPTY || chunks[slot].pos[0] != xPos || chunks[slot].pos[1] != yPos) {
+		return NULL;
+	}
+
+	return &chunks[slot];
+}
+
+// adds the blocks a freshly generated chunk placed in other chunks to the pending writes, and marks the loaded chunks
+// they go into, so they get placed once those chunks aren't in use (main thread)
+void add_pending_writes(struct BlockWrites* writes) {
+	for(int i = 0; i < (*writes).count; i++) {
+		struct BlockWrite write = (*writes).writes[i];
+
+		add_block_write(&pendingWrites, write);
+
+		struct Chunk* target = get_slot_chunk(write.chunkX, write.chunkZ);
+
+		if(target == NULL) {
+			continue;
+		}
+
+		// the chunk only gets the new writes, the ones placed before might have been broken by the player since
+		add_block_write(&(*get_chunk_job(target)).arrived, write);
+
+		if(!(*get_chunk_job(target)).hasPendingWrites) {
+			(*get_chunk_job(target)).hasPendingWrites = true;
+			pendingWriteChunks++;
+		}
+	}
+
+	clear_block_writes(writes);
+}
+
+// places the pending writes of every generated chunk that got some and isn't in use, and meshes them again (main thread)
+void place_pending_writes() {
+	for(int i = 0; i < chunkCount && pendingWriteChunks > 0; i++) {
+		struct ChunkJob* job = &chunkJobs[i];
+
+		if(!(*job).hasPendingWrites || (*job).state < CHUNK_GENERATED || is_chunk_in_use(&chunks[i])) {
+			continue;
+		}
+
+		(*job).hasPendingWrites = false;
+		pendingWriteChunks--;
+
+		// only the writes that arrived since the last time, so blocks that were broken since don't come back
+		bool changed = apply_block_writes_to_chunk(&(*job).arrived, &chunks[i]);
+
+		clear_block_writes(&(*job).arrived);
+
+		if(!changed) {
+			continue;
+		}
+
+		update_chunk_culling(&chunks[i]);
+
+		// the leaves can hide faces of the surrounding chunks as well
+		try_mesh_chunk(&chunks[i]);
+
+		struct Chunk* neighbours[4] = { chunks[i].leftChunk, chunks[i].rightChunk, chunks[i].topChunk, chunks[i].bottomChunk };
+
+		for(int n = 0; n < 4; n++) {
+			if(neighbours[n] != NULL) {
+				try_mesh_chunk(neighbours[n]);
+			}
+		}
+	}
+}
+
+// registers the freshly generated chunk in the world and meshes it and its surrounding chunks (main thread)
+void finish_generate_chunk_job(void* data) {
+	struct ChunkJob* job = data;
+	struct Chunk* chunk = (*job).chunk;
+
+	(*job).state = CHUNK_GENERATED;
+	(*job).busy = false;
+
+	clear_block_writes(&(*job).incoming);
+
+	// hand the parts of its trees that went over its borders to the chunks they go into
+	add_pending_writes(&(*job).outgoing);
+
+	// register it in the chunk map and link it up with its surrounding chunks
+	chunk_map_insert(&chunkMap, (*chunk).pos[0], (*chunk).pos[1], chunk);
+	link_chunk(chunk);
+
+	// mesh it, and mesh the surrounding chunks again so the faces bordering it get hidden
+	try_mesh_chunk(chunk);
+
+	struct Chunk* neighbours[4] = { (*chunk).leftChunk, (*chunk).rightChunk, (*chunk).topChunk, (*chunk).bottomChunk };
+
+	for(int i = 0; i < 4; i++) {
+		if(neighbours[i] != NULL) {
+			try_mesh_chunk(neighbours[i]);
+		}
+	}
+}
+
+// queues up the chunk to be meshed on a worker, once it and all its surrounding chunks within the loaded area are generated
+void try_mesh_chunk(struct Chunk* chunk) {
+	struct ChunkJob* job = get_chunk_job(chunk);
+
+	int x = (*chunk).pos[0];
+	int z = (*chunk).pos[1];
+
+	// not generated yet, or about to be unloaded
+	if((*job).state < CHUNK_GENERATED || !is_chunk_in_range(x, z)) {
+		return;
+	}
+
+	// already being worked on, mesh it again afterwards
+	if((*job).busy) {
+		(*job).needsRemesh = true;
+		return;
+	}
+
+	// wait for every surrounding chunk within the loaded area (the rest count as the edge of the world)
+	struct Chunk* neighbours[4] = { (*chunk).leftChunk, (*chunk).rightChunk, (*chunk).topChunk, (*chunk).bottomChunk };
+	int neighbourPos[4][2] = { {x-1, z}, {x+1, z}, {x, z+1}, {x, z-1} };
+
+	for(int i = 0; i < 4; i++) {
+		if(neighbours[i] == NULL && is_chunk_in_range(neighbourPos[i][0], neighbourPos[i][1])) {
+			return;
+		}
+	}
+
+	// the surrounding chunks get read by the worker, so they can't be unloaded or edited until its done
+	for(int i = 0; i < 4; i++) {
+		(*job).meshNeighbours[i] = neighbours[i];
+
+		if(neighbours[i] != NULL) {
+			(*get_chunk_job(neighbours[i])).readers++;
+		}
+	}
+
+	(*job).busy = true;
+
+	init_mesh_builder(&(*job).builder);
+	submit_worker_job(mesh_chunk_job, finish_mesh_chunk_job, job);
+}
+
+
+// ---
+
+
+// unlinks a chunk from the world and starts generating the chunk at new chunk coordinates into its slot (main thread)
+void load_chunk(struct Chunk* chunk, int xPos, int yPos) {
+	struct ChunkJob* job = get_chunk_job(chunk);
+
+	// take the old chunk out of the world
+	if((*job).state != CHUNK_EMPTY) {
+		chunk_map_remove(&chunkMap, (*chunk).pos[0], (*chunk).pos[1]);
+
+		if((*chunk).leftChunk != NULL) {
+			(*(*chunk).leftChunk).rightChunk = NULL;
+		}
+		if((*chunk).rightChunk != NULL) {
+			(*(*chunk).rightChunk).leftChunk = NULL;
+		}
+		if((*chunk).topChunk != NULL) {
+			(*(*chunk).topChunk).bottomChunk = NULL;
+		}
+		if((*chunk).bottomChunk != NULL) {
+			(*(*chunk).bottomChunk).topChunk = NULL;
+		}
+
+		(*chunk).leftChunk = NULL;
+		(*chunk).rightChunk = NULL;
+		(*chunk).topChunk = NULL;
+		(*chunk).bottomChunk = NULL;
+
+		// the blocks it placed in other chunks are made again if it gets loaded back in
+		remove_block_writes_from(&pendingWrites, (*chunk).pos[0], (*chunk).pos[1]);
+
+		for(int i = 0; i < chunkCount; i++) {
+			if(chunkJobs[i].hasPendingWrites) {
+				remove_block_writes_from(&chunkJobs[i].arrived, (*chunk).pos[0], (*chunk).pos[1]);
+			}
+		}
+
+		// and the ones that were on their way into it are for the old chunk
+		clear_block_writes(&(*job).arrived);
+
+		if((*job).hasPendingWrites) {
+			(*job).hasPendingWrites = false;
+			pendingWriteChunks--;
+		}
+	}
+
+	// move it over to the new position, the old mesh isn't drawn anymore but its space in the mesh arena is kept for reuse
+	glm_vec2_copy((vec2){xPos, yPos}, (*chunk).pos);
+	(*chunk).indexCount = 0;
+
+	// edits to the old chunk don't matter anymore
+	(*chunk).dirtySections = 0;
+	(*chunk).cullingDirty = false;
+
+	// hand it the blocks the loaded chunks around it already placed in it
+	copy_block_writes_into(&pendingWrites, xPos, yPos, &(*job).incoming);
+
+	// and generate its blocks on a worker
+	(*job).state = CHUNK_GENERATING;
+	(*job).busy = true;
+	(*job).needsRemesh = false;
+
+	submit_worker_job(generate_chunk_job, finish_generate_chunk_job, job);
+}
+
+// switches every chunk slot that holds the wrong chunk over to the chunk that belongs in it, returns false if some slots
+// couldn't be switched yet because their chunks are still in use by the workers
+bool update_chunk_slots() {
+	bool done = true;
+
+	for(int i = 0; i < chunkCount; i++) {
+		int xPos;
+		int yPos;
+		get_slot_chunk_pos(i, &xPos, &yPos);
+
+		// already holding (or loading) the right chunk
+		if(chunkJobs[i].state != CHUNK_EMPTY && chunks[i].pos[0] == xPos && chunks[i].pos[1] == yPos) {
+			continue;
+		}
+
+		// still being worked on, try again later
+		if(is_chunk_in_use(&chunks[i])) {
+			done = false;
+			continue;
+		}
+
+		load_chunk(&chunks[i], xPos, yPos);
+	}
+
+	return done;
+}
+
+
+// ---
+
+
+// sets up a ringSize x ringSize buffer of chunks, that either streams around a centre chunk, or holds a fixed grid of chunks
+void init_chunk_loader(int size, bool streamAround, int centreX, int centreY, ChunkMeshHandler meshHandler) {
+	ringSize = size;
+	chunkCount = ringSize*ringSize;
+
+	streaming = streamAround;
+	streamDistance = ringSize / 2;
+
+	streamCentre[0] = centreX;
+	streamCentre[1] = centreY;
+
+	chunkMeshHandler = meshHandler;
+
+	// allocate size to chunks
+	chunks = calloc(chunkCount, sizeof(struct Chunk));
+
+	// one job per chunk slot, handed to the worker threads
+	chunkJobs = calloc(chunkCount, sizeof(struct ChunkJob));
+
+	// create the chunk map, sized for all the loaded chunks
+	init_chunk_map(&chunkMap, chunkCount);
+
+	// set up every chunk slot
+	for(int i = 0; i < chunkCount; i++) {
+		init_chunk(&chunks[i], GLM_VEC2_ZERO);
+
+		chunkJobs[i].chunk = &chunks[i];
+		chunkJobs[i].state = CHUNK_EMPTY;
+
+		init_block_writes(&chunkJobs[i].incoming);
+		init_block_writes(&chunkJobs[i].arrived);
+		init_block_writes(&chunkJobs[i].outgoing);
+	}
+
+	init_block_writes(&pendingWrites);
+	pendingWriteChunks = 0;
+
+	// every slot still needs its chunk loaded in
+	streamingDirty = true;
+}
+
+// moves the centre that the loaded chunks stream around
+void set_chunk_loader_centre(int xPos, int yPos) {
+	if(!streaming || (xPos == streamCentre[0] && yPos == streamCentre[1])) {
+		return;
+	}
+
+	streamCentre[0] = xPos;
+	streamCentre[1] = yPos;
+
+	streamingDirty = true;
+}
+
+// loads in the chunks that came into range, and hands up to maxMeshes finished meshes to the mesh handler
+void update_chunk_loader(int maxMeshes) {
+	// swap out the chunks that fell out of range for the ones that came into it
+	if(streamingDirty) {
+		streamingDirty = !update_chunk_slots();
+	}
+
+	// handle whatever the workers have finished
+	finish_worker_jobs(maxMeshes);
+
+	// place the blocks that newly generated chunks placed in chunks that were already there
+	if(pendingWriteChunks > 0) {
+		place_pending_writes();
+	}
+}
+
+
+// ---
+
+
+// getters for the buffer of chunks
+struct Chunk* get_loaded_chunks() {
+	return chunks;
+}
+int get_loaded_chunk_count() {
+	return chunkCount;
+}
+
+
+// ---
+
+
+// frees the chunks
+void terminate_chunk_loader() {
+	for(int i = 0; i < chunkCount; i++) {
+		free_chunk_blocks(&chunks[i]);
+
+		free_block_writes(&chunkJobs[i].incoming);
+		free_block_writes(&chunkJobs[i].arrived);
+		free_block_writes(&chunkJobs[i].outgoing);
+	}
+
+	free_block_writes(&pendingWrites);
+	pendingWriteChunks = 0;
+
+	free(chunks);
+	free(chunkJobs);
+	free_chunk_map(&chunkMap);
+
+	chunks = NULL;
+	chunkJobs = NULL;
+	chunkCount = 0;
+}
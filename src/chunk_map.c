@@ -0,0 +1,192 @@
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "headers/chunk_map.h"
+
+
+// ---
+
+
+// settings
+
+// smallest amount of slots a map is allocated with
+const int CHUNK_MAP_MIN_CAPACITY = 16;
+
+
+// ---
+
+
+// hashes chunk coordinates into a slot index of a map with the given capacity
+int hash_chunk_coords(int x, int z, int capacity) {
+	// mix the coordinates with two large primes, so neighbouring chunks end up spread apart
+	uint32_t hash = (uint32_t)x * 73856093u ^ (uint32_t)z * 19349663u;
+
+	// fold the high bits down, as the capacity mask only keeps the low ones
+	hash ^= hash >> 16;
+
+	return hash & (capacity-1);
+}
+
+
+// ---
+
+
+// allocates empty slots for a map, capacity has to be a power of two
+void alloc_chunk_map(struct ChunkMap* map, int capacity) {
+	(*map).entries = calloc(capacity, sizeof(struct ChunkMapEntry));
+	(*map).count = 0;
+	(*map).capacity = capacity;
+}
+
+// initiates an empty chunk map that can hold chunkAmount chunks while staying at most half full
+void init_chunk_map(struct ChunkMap* map, int chunkAmount) {
+
+	int capacity = CHUNK_MAP_MIN_CAPACITY;
+
+	while(capacity < chunkAmount*2) {
+		capacity *= 2;
+	}
+
+	alloc_chunk_map(map, capacity);
+
+}
+
+
+// ---
+
+
+// gets the chunk at the given chunk coordinates, NULL if there isn't one
+struct Chunk* chunk_map_get(struct ChunkMap* map, int x, int z) {
+
+	int slot = hash_chunk_coords(x, z, (*map).capacity);
+
+	// walk along the slots until either the chunk or an empty slot is found
+	while((*map).entries[slot].chunk != NULL) {
+
+		if((*map).entries[slot].x == x && (*map).entries[slot].z == z) {
+			return (*map).entries[slot].chunk;
+		}
+
+		slot = (slot+1) & ((*map).capacity-1);
+
+	}
+
+	return NULL;
+
+}
+
+
+// ---
+
+
+// puts a chunk into the map at the given chunk coordinates, replacing whatever was there before
+void chunk_map_insert(struct ChunkMap* map, int x, int z, struct Chunk* chunk) {
+
+	// keep the map at most half full so the probes stay short, doubling it if needed
+	if(((*map).count+1)*2 > (*map).capacity) {
+
+		struct ChunkMapEntry* oldEntries = (*map).entries;
+		int oldCapacity = (*map).capacity;
+
+		alloc_chunk_map(map, oldCapacity*2);
+
+		// move every chunk over into the new slots
+		for(int i = 0; i < oldCapacity; i++) {
+			if(oldEntries[i].chunk != NULL) {
+				chunk_map_insert(map, oldEntries[i].x, oldEntries[i].z, oldEntries[i].chunk);
+			}
+		}
+
+		free(oldEntries);
+
+	}
+
+
+	// ---
+
+
+	int slot = hash_chunk_coords(x, z, (*map).capacity);
+
+	// walk along the slots until either the same coordinates or an empty slot is found
+	while((*map).entries[slot].chunk != NULL) {
+
+		// already in the map, just replace the chunk
+		if((*map).entries[slot].x == x && (*map).entries[slot].z == z) {
+			(*map).entries[slot].chunk = chunk;
+			return;
+		}
+
+		slot = (slot+1) & ((*map).capacity-1);
+
+	}
+
+	(*map).entries[slot] = (struct ChunkMapEntry){ x, z, chunk };
+	(*map).count++;
+
+}
+
+
+// ---
+
+
+// removes the chunk at the given chunk coordinates from the map
+void chunk_map_remove(struct ChunkMap* map, int x, int z) {
+
+	int mask = (*map).capacity-1;
+
+	int slot = hash_chunk_coords(x, z, (*map).capacity);
+
+	// find the slot holding the chunk
+	while((*map).entries[slot].chunk != NULL) {
+
+		if((*map).entries[slot].x == x && (*map).entries[slot].z == z) {
+			break;
+		}
+
+		slot = (slot+1) & mask;
+
+	}
+
+	// not in the map
+	if((*map).entries[slot].chunk == NULL) {
+		return;
+	}
+
+	// empty the slot
+	(*map).entries[slot].chunk = NULL;
+	(*map).count--;
+
+	// shift the chunks after it back into the gap where they can, so lookups never stop early at it
+	int next = (slot+1) & mask;
+
+	while((*map).entries[next].chunk != NULL) {
+
+		// slot the chunk would ideally be in
+		int home = hash_chunk_coords((*map).entries[next].x, (*map).entries[next].z, (*map).capacity);
+
+		// the chunk can move into the gap unless its home lies (cyclically) in between the gap and where it is now
+		if( ((next - home) & mask) >= ((next - slot) & mask) ) {
+			(*map).entries[slot] = (*map).entries[next];
+			(*map).entries[next].chunk = NULL;
+
+			slot = next;
+		}
+
+		next = (next+1) & mask;
+
+	}
+
+}
+
+
+// ---
+
+
+// frees the memory held by a chunk map
+void free_chunk_map(struct ChunkMap* map) {
+	free((*map).entries);
+
+	(*map).entries = NULL;
+	(*map).count = 0;
+	(*map).capacity = 0;
+}
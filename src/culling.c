@@ -0,0 +1,353 @@
+#include "../include/CGLM/cglm.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "headers/chunk.h"
+#include "headers/culling.h"
+#include "headers/occlusion.h"
+
+// works out which chunks need drawing and in what order, doesn't touch opengl, so it can be run without a window
+
+
+// ---
+
+
+// furthest a chunk can be from the centre chunk along either axis and still be sorted by its exact distance, the loaded chunks
+// fit in MAX_CHUNK_SLOTS, so they're at most 11 chunks across, and the centre is the camera's chunk within them (chunks further
+// away than this only come up when the camera leaves a world that isn't streamed, and are all put last)
+#define SORT_MAX_OFFSET 12
+
+// biggest squared distance the chunks are sorted by
+#define SORT_MAX_KEY (2*SORT_MAX_OFFSET*SORT_MAX_OFFSET)
+
+// squared distance of every chunk being sorted
+int sortKeys[MAX_CHUNK_SLOTS];
+
+// amount of chunks at each squared distance, turned into the index the first chunk at that distance goes to
+int sortStarts[SORT_MAX_KEY+1];
+
+
+// ---
+
+
+// sorts the indices of chunk positions from nearest to furthest from a centre chunk
+void sort_chunks_by_distance(int (*positions)[2], int count, int centreX, int centreZ, int* order) {
+
+	// squared distance of every chunk, which is a whole number, so the chunks can be counting sorted by it
+	int* keys = sortKeys;
+	int maxKey = 0;
+
+	for(int i = 0; i < count; i++) {
+		int dx = positions[i][0] - centreX;
+		int dz = positions[i][1] - centreZ;
+
+		keys[i] = dx*dx + dz*dz;
+
+		if(keys[i] > SORT_MAX_KEY) {
+			keys[i] = SORT_MAX_KEY;
+		}
+
+		if(keys[i] > maxKey) {
+			maxKey = keys[i];
+		}
+	}
+
+	// only the distances that came up have to be cleared
+	int* starts = sortStarts;
+	memset(starts, 0, sizeof(int) * (maxKey+1));
+
+	for(int i = 0; i < count; i++) {
+		starts[keys[i]]++;
+	}
+
+	int total = 0;
+
+	for(int key = 0; key <= maxKey; key++) {
+		int amount = starts[key];
+
+		starts[key] = total;
+		total += amount;
+	}
+
+	// chunks at the same distance keep the order they came in
+	for(int i = 0; i < count; i++) {
+		order[starts[keys[i]]++] = i;
+	}
+
+}
+
+
+// ---
+
+
+// writes the indices out of order of the chunks whose bounding boxes are at least partly inside the view frustum
+int cull_chunks_frustum(mat4 viewProj, struct Chunk* chunks, int* order, int count, int* visible) {
+
+	// planes of the frustum, in world space, pointing inwards
+	vec4 planes[6];
+	glm_frustum_planes(viewProj, planes);
+
+	// size of the bounding box of a chunk (water sits a bit lower than the blocks, so it starts a block below 0)
+	vec3 boxSize = { CHUNK_WIDTH, CHUNK_HEIGHT+1, CHUNK_LENGTH };
+
+	// every box is the same size, so how far its corner furthest along a plane's normal is from its minimum corner
+	// is the same for every chunk, and gets worked out once per plane instead of once per chunk
+	float reach[6];
+
+	for(int p = 0; p < 6; p++) {
+		reach[p] = planes[p][3];
+
+		for(int i = 0; i < 3; i++) {
+			if(planes[p][i] > 0) {
+				reach[p] += planes[p][i] * boxSize[i];
+			}
+		}
+	}
+
+	int visibleCount = 0;
+
+	for(int i = 0; i < count; i++) {
+		struct Chunk* chunk = &chunks[order[i]];
+
+		vec3 boxMin = { (*chunk).pos[0]*CHUNK_WIDTH, -1, (*chunk).pos[1]*CHUNK_LENGTH };
+
+		// outside if even the furthest corner is behind one of the planes
+		bool inside = true;
+
+		for(int p = 0; p < 6; p++) {
+			if(glm_vec3_dot(planes[p], boxMin) + reach[p] < 0) {
+				inside = false;
+				break;
+			}
+		}
+
+		if(inside) {
+			visible[visibleCount++] = order[i];
+		}
+	}
+
+	return visibleCount;
+
+}
+
+
+// ---
+
+
+// gets the bit of a chunk's face connections that says whether or not two different faces are connected
+int get_face_pair_bit(int faceA, int faceB) {
+	if(faceA > faceB) {
+		int face = faceA;
+		faceA = faceB;
+		faceB = face;
+	}
+
+	// pairs are numbered in order, (0, 1) ... (0, 5), (1, 2) ... (4, 5)
+	return faceA*(2*FACE_COUNT - faceA - 1)/2 + faceB - faceA - 1;
+}
+
+// spreads the flood fill to a surrounding block if its inside the chunk (and open), otherwise notes down the face its past
+#define SPREAD_FLOOD_FILL(inside, neighbour, face) \
+	if(!(inside)) { \
+		faces |= FACE_BIT(face); \
+	} \
+	else if(blockTypes[neighbour]) { \
+		blockTypes[neighbour] = false; \
+		queue[queueEnd++] = neighbour; \
+	}
+
+// works out which pairs of a chunk's faces are connected thru its non solid blocks
+uint16_t calc_chunk_face_connections(struct Chunk* chunk) {
+
+	// the blocks of the chunk, turned into whether or not they're open (non solid and not reached by the flood fill yet)
+	int8_t blockTypes[CHUNK_VOLUME];
+
+	// no blocks stand in the way if the chunk is all air (or all water)
+	bool open = true;
+
+	for(int section = 0; section < CHUNK_SECTIONS; section++) {
+		int type = get_section_type(chunk, section);
+
+		if(type == SECTION_MIXED || is_block_solid(type)) {
+			open = false;
+		}
+
+		unpack_block_storage(&(*chunk).sections[section], blockTypes + section*SECTION_VOLUME);
+	}
+
+	if(open) {
+		return ALL_FACE_CONNECTIONS;
+	}
+
+	// looking the types up in the registry once per type, rather than once per block
+	bool openTypes[MAX_BLOCK_TYPE - MIN_BLOCK_TYPE + 1];
+
+	for(int type = MIN_BLOCK_TYPE; type <= MAX_BLOCK_TYPE; type++) {
+		openTypes[type - MIN_BLOCK_TYPE] = !is_block_solid(type);
+	}
+
+	for(int i = 0; i < CHUNK_VOLUME; i++) {
+		blockTypes[i] = openTypes[blockTypes[i] - MIN_BLOCK_TYPE];
+	}
+
+	// blocks waiting to be spread from
+	uint16_t queue[CHUNK_VOLUME];
+
+	uint16_t connections = 0;
+
+	for(int start = 0; start < CHUNK_VOLUME; start++) {
+
+		if(!blockTypes[start]) {
+			continue;
+		}
+
+		// flood fill every non solid block connected to this one, noting down which faces of the chunk it reaches
+		int faces = 0;
+
+		int queueStart = 0;
+		int queueEnd = 0;
+
+		queue[queueEnd++] = start;
+		blockTypes[start] = false;
+
+		while(queueStart < queueEnd) {
+			int index = queue[queueStart++];
+
+			int x = index % CHUNK_LENGTH;
+			int z = (index / CHUNK_LENGTH) % CHUNK_WIDTH;
+			int y = index / (CHUNK_WIDTH*CHUNK_LENGTH);
+
+			// spread to the surrounding blocks, noting down the face of the chunk that's there instead when they're outside of it
+			SPREAD_FLOOD_FILL(z < CHUNK_LENGTH-1, index + CHUNK_LENGTH, FACE_FRONT);
+			SPREAD_FLOOD_FILL(z > 0, index - CHUNK_LENGTH, FACE_BACK);
+			SPREAD_FLOOD_FILL(x > 0, index - 1, FACE_LEFT);
+			SPREAD_FLOOD_FILL(x < CHUNK_WIDTH-1, index + 1, FACE_RIGHT);
+			SPREAD_FLOOD_FILL(y > 0, index - CHUNK_WIDTH*CHUNK_LENGTH, FACE_BOTTOM);
+			SPREAD_FLOOD_FILL(y < CHUNK_HEIGHT-1, index + CHUNK_WIDTH*CHUNK_LENGTH, FACE_TOP);
+		}
+
+		// every pair of faces the filled area reaches is connected
+		for(int a = 0; a < FACE_COUNT; a++) {
+			for(int b = a+1; b < FACE_COUNT; b++) {
+				if((faces & FACE_BIT(a)) && (faces & FACE_BIT(b))) {
+					connections |= 1 << get_face_pair_bit(a, b);
+				}
+			}
+		}
+
+		if(connections == ALL_FACE_CONNECTIONS) {
+			break;
+		}
+
+	}
+
+	return connections;
+
+}
+
+// works out everything culling needs from a chunk's blocks, its face connections and occluders
+void update_chunk_culling(struct Chunk* chunk) {
+	(*chunk).faceConnections = calc_chunk_face_connections(chunk);
+
+	calc_chunk_occluders(chunk, &(*chunk).occluders);
+}
+
+
+// ---
+
+
+// the face across a chunk from another
+const int OPPOSITE_FACES[FACE_COUNT] = { FACE_BACK, FACE_FRONT, FACE_RIGHT, FACE_LEFT, FACE_TOP, FACE_BOTTOM };
+
+// chunk steps (x, layer, z) taken when leaving a chunk thru each of its faces
+const int FACE_STEPS[FACE_COUNT][3] = {
+	{ 0, 0, 1 }, { 0, 0, -1 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 }, { 0, 1, 0 }
+};
+
+// the cave culling walk goes thru two layers of cells, the chunks, and the open air above them (which connects everything)
+#define CULL_LAYERS 2
+
+// a cell the walk has reached
+struct CullStep {
+	int x, layer, z; // relative to the camera's chunk (plus range)
+	int entryFace; // face it was entered thru, -1 for the cell the camera is in
+	int directions; // faces the walk has left cells thru on the way here, it never goes back the opposite way
+};
+
+// works out which chunks could be seen from the camera thru the open faces of the chunks in between
+void cull_chunks_caves(ChunkLookup lookup, struct Chunk* chunks, int range, int cameraX, int cameraZ, bool cameraAbove,
+	bool* inView, bool* visible) {
+
+	int side = 2*range + 1;
+	int cellCount = side*side*CULL_LAYERS;
+
+	bool* reached = calloc(cellCount, sizeof(bool));
+	struct CullStep* queue = malloc(sizeof(struct CullStep) * cellCount);
+
+	int queueStart = 0;
+	int queueEnd = 0;
+
+	// the camera is in the air above the chunks if its above them, or if its chunk isn't there
+	int startLayer = cameraAbove || lookup(cameraX, cameraZ) == NULL ? 1 : 0;
+
+	queue[queueEnd++] = (struct CullStep){ range, startLayer, range, -1, 0 };
+	reached[(startLayer*side + range)*side + range] = true;
+
+	while(queueStart < queueEnd) {
+		struct CullStep step = queue[queueStart++];
+
+		struct Chunk* chunk = NULL;
+
+		if(step.layer == 0) {
+			chunk = lookup(cameraX + step.x - range, cameraZ + step.z - range);
+
+			visible[chunk - chunks] = true;
+		}
+
+		for(int face = 0; face < FACE_COUNT; face++) {
+
+			// never head back towards the camera
+			if(step.directions & FACE_BIT(OPPOSITE_FACES[face])) {
+				continue;
+			}
+
+			// can only leave a chunk thru a face that can be seen from the one it was entered thru
+			if(chunk != NULL && step.entryFace >= 0 && face != step.entryFace
+				&& !((*chunk).faceConnections & (1 << get_face_pair_bit(step.entryFace, face)))) {
+				continue;
+			}
+
+			int x = step.x + FACE_STEPS[face][0];
+			int layer = step.layer + FACE_STEPS[face][1];
+			int z = step.z + FACE_STEPS[face][2];
+
+			if(x < 0 || x >= side || z < 0 || z >= side || layer < 0 || layer >= CULL_LAYERS) {
+				continue;
+			}
+
+			int cell = (layer*side + z)*side + x;
+
+			if(reached[cell]) {
+				continue;
+			}
+
+			// chunks have to be there and in view to be walked thru (the air above them is always open)
+			if(layer == 0) {
+				struct Chunk* next = lookup(cameraX + x - range, cameraZ + z - range);
+
+				if(next == NULL || !inView[next - chunks]) {
+					continue;
+				}
+			}
+
+			reached[cell] = true;
+
+			queue[queueEnd++] = (struct CullStep){ x, layer, z, OPPOSITE_FACES[face], step.directions | FACE_BIT(face) };
+		}
+	}
+
+	free(reached);
+	free(queue);
+
+}
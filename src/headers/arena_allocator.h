@@ -0,0 +1,44 @@
+#ifndef ARENA_ALLOCATOR_H
+#define ARENA_ALLOCATOR_H
+
+#include <stdbool.h>
+
+// a free range of an arena, in whatever units the arena is counted in
+struct ArenaRange {
+	int start;
+	int size;
+};
+
+// hands out ranges of a fixed size arena (such as a gpu buffer) without touching the memory itself, by keeping a list of
+// the free ranges sorted by where they start, so released ranges can be merged back in with the ones next to them
+struct ArenaAllocator {
+	struct ArenaRange* freeRanges;
+	int freeCount; // amount of free ranges in the list
+	int freeCapacity; // amount of free ranges allocated for
+
+	int capacity; // size of the whole arena
+	int used; // amount of it that has been handed out
+};
+
+// initiates an allocator with the whole arena free
+void init_arena_allocator(struct ArenaAllocator* allocator, int capacity);
+
+// hands out size units of the arena out of the smallest free range they fit in, returns where they start (-1 if they don't fit)
+int arena_allocate(struct ArenaAllocator* allocator, int size);
+
+// gives a range back to the arena
+void arena_release(struct ArenaAllocator* allocator, int start, int size);
+
+// makes the arena bigger, the new space is free
+void grow_arena_allocator(struct ArenaAllocator* allocator, int capacity);
+
+// frees up the whole arena (for handing every range out again from the start, when defragmenting)
+void reset_arena_allocator(struct ArenaAllocator* allocator);
+
+// getter for the size of the biggest free range
+int get_arena_largest_free(struct ArenaAllocator* allocator);
+
+// frees the memory held by an allocator
+void free_arena_allocator(struct ArenaAllocator* allocator);
+
+#endif
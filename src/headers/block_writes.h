@@ -0,0 +1,50 @@
+#ifndef BLOCK_WRITES_H
+#define BLOCK_WRITES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "chunk.h"
+
+// a block that has to be placed in a chunk, made by (and kept around for as long as) a source chunk
+struct BlockWrite {
+	int sourceX, sourceZ; // chunk coordinates of the chunk that made the write
+	int chunkX, chunkZ; // chunk coordinates of the chunk it goes into
+
+	int x, y, z; // position within that chunk
+	int type; // block type to place
+};
+
+// growable list of block writes
+struct BlockWrites {
+	struct BlockWrite* writes;
+	int count; // amount of writes in the list
+	int capacity; // amount of writes allocated for
+};
+
+// initiates an empty list of block writes (nothing is allocated until the first write is added)
+void init_block_writes(struct BlockWrites* list);
+
+// appends a block write to a list
+void add_block_write(struct BlockWrites* list, struct BlockWrite write);
+
+// appends every write of a list that goes into the chunk at chunkX, chunkZ to another list
+void copy_block_writes_into(struct BlockWrites* list, int chunkX, int chunkZ, struct BlockWrites* destination);
+
+// removes every write made by the chunk at sourceX, sourceZ from a list
+void remove_block_writes_from(struct BlockWrites* list, int sourceX, int sourceZ);
+
+// places the writes of a list that go into a chunk, only into air, so writes from different chunks can be applied in any order
+// (blockTypes is an unpacked array of the chunk's CHUNK_VOLUME blocks), returns whether or not any block changed
+bool apply_block_writes(struct BlockWrites* list, int chunkX, int chunkZ, int8_t* blockTypes);
+
+// same as apply_block_writes, but on the packed blocks of a chunk that has already been generated
+bool apply_block_writes_to_chunk(struct BlockWrites* list, struct Chunk* chunk);
+
+// empties a list while keeping its memory
+void clear_block_writes(struct BlockWrites* list);
+
+// frees the memory held by a list of block writes
+void free_block_writes(struct BlockWrites* list);
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef BLOCKS_H
+#define BLOCKS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+struct Chunk;
+
+// sides of a block, in the order that they are meshed in
+enum BlockFace { FACE_FRONT, FACE_BACK, FACE_LEFT, FACE_RIGHT, FACE_BOTTOM, FACE_TOP };
+
+// amount of sides a block has
+#define FACE_COUNT 6
+
+// bit of a side within a face bitmask
+#define FACE_BIT(face) (1 << (face))
+
+// every side of a block in a face bitmask
+#define ALL_FACES 0x3F
+
+// render layers (as bits) that the sides of a block get drawn in
+#define RENDER_LAYER_OPAQUE 1 // drawn with the rest of the chunk
+#define RENDER_LAYER_TRANSLUCENT 2 // see thru, drawn after the opaque layer (water)
+
+// lowest and highest block type ids
+#define MIN_BLOCK_TYPE -1
+#define MAX_BLOCK_TYPE 10
+
+// everything the mesher needs to know about a block type, looked up by id in the block registry
+struct BlockInfo {
+	const char* name; // name of the type
+
+	bool solid; // whether it hides the sides of the blocks next to it
+	int faces; // face bitmask of the sides it has (air has none, water has no bottom)
+	int renderLayers; // render layer bits its sides are drawn in
+
+	float yOff; // how far its sides are sunk down (water sits a bit lower than a full block)
+
+	int tiles[FACE_COUNT][2]; // column and row of the atlas tile of each side
+	int mirroredFaces; // face bitmask of the sides whose texture is flipped horizontally
+};
+
+// gets the registry entry of a block type (unknown types get the air entry)
+const struct BlockInfo* get_block_info(int type);
+
+// whether or not a block type hides the sides of the blocks next to it
+bool is_block_solid(int type);
+
+// most block types a single palette can hold (8 bit indices)
+#define MAX_PALETTE_SIZE 256
+
+// palette compressed block types, every block is stored as a 1, 2, 4 or 8 bit index into a palette of the types that appear
+// (the layout is self contained, so it can be written to disk as is)
+struct BlockStorage {
+	uint64_t* data; // packed palette indices, NULL when the palette only holds a single type (every block is palette[0])
+
+	int bits; // bits per index (0, 1, 2, 4 or 8)
+	int blockAmount; // amount of blocks stored
+
+	int paletteSize; // amount of types in the palette
+	int8_t palette[MAX_PALETTE_SIZE]; // block types, indexed by the packed indices
+};
+
+// takes an int and returns the string counterpart to that int block type
+const char* int_to_string_block_type(int type);
+
+// initiates a block storage of given size that is filled with a single type (nothing is allocated until a second type is set)
+void init_block_storage(struct BlockStorage* storage, int blockAmount, int type);
+
+// gets the type of the block at an index of a block storage
+int get_storage_block(struct BlockStorage* storage, int index);
+
+// sets the type of the block at an index of a block storage, growing the palette (and index size) if the type is new to it
+void set_storage_block(struct BlockStorage* storage, int index, int type);
+
+// replaces the contents of a block storage with an array of blockAmount block types, using the smallest palette that fits them
+void pack_block_storage(struct BlockStorage* storage, const int8_t* types);
+
+// writes out the type of every block of a block storage into an array of blockAmount block types
+void unpack_block_storage(struct BlockStorage* storage, int8_t* types);
+
+// gets the amount of memory held by a block storage in bytes
+int get_block_storage_size(struct BlockStorage* storage);
+
+// frees the memory held by a block storage, leaving it filled with air
+void free_block_storage(struct BlockStorage* storage);
+
+// returned by get_section_type for sections that hold more than one type
+#define SECTION_MIXED 127
+
+// fills every section of a chunk with a single type (which doesn't need any memory)
+void init_chunk_blocks(struct Chunk* chunk, int type);
+
+// replaces the blocks of a chunk with an array of CHUNK_VOLUME block types, sections of a single type get stored as just that type
+void pack_chunk_blocks(struct Chunk* chunk, const int8_t* types);
+
+// gets the amount of memory held by the blocks of a chunk in bytes
+int get_chunk_blocks_size(struct Chunk* chunk);
+
+// frees the memory held by the blocks of a chunk, leaving it filled with air
+void free_chunk_blocks(struct Chunk* chunk);
+
+// gets the type that every block of a chunk section is, or SECTION_MIXED if they aren't all the same
+int get_section_type(struct Chunk* chunk, int section);
+
+// gets the block type of a block within a chunk
+int get_block_type(struct Chunk* chunk, int xPos, int yPos, int zPos);
+
+// returns the actual index of a block at given relative coordinates to chunk
+int get_block_index(int xPos, int yPos, int zPos);
+
+// sets the block type of a block within a chunk
+void set_block_type(struct Chunk* chunk, int xPos, int yPos, int zPos, int type);
+
+#endif
@@ -4,52 +4,108 @@
 #include "../include/CGLM/cglm.h"
 
 #include "mesh.h"
+#include "mesh_builder.h"
+#include "blocks.h"
+
+// chunk size settings
+#define CHUNK_WIDTH  32 // x
+#define CHUNK_HEIGHT 32 // y
+#define CHUNK_LENGTH 32 // z
+
+// amount of blocks in a chunk
+#define CHUNK_VOLUME (CHUNK_WIDTH*CHUNK_HEIGHT*CHUNK_LENGTH)
+
+// chunks are split up vertically into sections of this many blocks, each stored on its own
+#define SECTION_HEIGHT 8
+
+// amount of sections in a chunk, and blocks in a section
+#define CHUNK_SECTIONS (CHUNK_HEIGHT/SECTION_HEIGHT)
+#define SECTION_VOLUME (CHUNK_WIDTH*SECTION_HEIGHT*CHUNK_LENGTH)
 
 // toggles fog visibility
 void toggle_fog();
 
-// randomizes the noise offset
-void randomize_noise_offset();
-
 // getters for chunk sizes
 int get_chunk_width();
 int get_chunk_length();
 int get_chunk_height();
 
-// just returns the constant value of the water level float
-float get_water_level();
-
 // whether or not the player is under the water level - getter and setter
 bool get_under_water_level();
 void set_under_water_level(bool value);
 
-// calculates noise value as integer block y coordinate at given position, allows for offsetting with chunk coords
-int calc_chunk_noise_value(vec2 position, vec2* chunkOffset);
+// chunks are split up into columns of OCCLUDER_SIZE x OCCLUDER_SIZE blocks for occlusion culling
+#define OCCLUDER_SIZE 8
+#define OCCLUDER_COLUMNS ((CHUNK_WIDTH/OCCLUDER_SIZE)*(CHUNK_LENGTH/OCCLUDER_SIZE))
+
+// the parts of a chunk that are solid enough to hide whatever is behind them, as boxes (see occlusion.h)
+struct ChunkOccluders {
+	uint8_t groundHeights[OCCLUDER_COLUMNS]; // how high up every column of blocks is solid from the bottom, lowest in each column area
+	uint64_t solidRegions; // a bit per OCCLUDER_SIZE cubed region above that is completely solid (layer*OCCLUDER_COLUMNS + column)
 
-// gets the block type of a block within a chunk
-int get_block_type(int* blockTypes, int xPos, int yPos, int zPos);
+	uint8_t topHeight; // one above the highest block that isn't air (the top of the chunk's bounding box)
+};
+
+// face connections of a chunk that every face can be seen thru from every other one (all 15 pairs)
+#define ALL_FACE_CONNECTIONS 0x7FFF
 
 // chunk structure
 struct Chunk {
 	vec2 pos; // multiplied by CHUNK_WIDTH and CHUNK_HEIGHT
 	
-	int sides; // how many sides to render (used when drawing it)
+	int indexCount; // exact amount of indices in the chunk mesh, across all its sections (used when drawing it)
 	
-	int* blockTypes; // array of block types
+	struct BlockStorage sections[CHUNK_SECTIONS]; // palette compressed block types of each section, bottom to top
+
+	uint16_t faceConnections; // which pairs of its faces are connected thru its non solid blocks (see culling.h)
+
+	struct ChunkOccluders occluders; // solid parts of the chunk that hide the chunks behind them (see occlusion.h)
 	
-	struct Mesh mesh; // mesh of chunk
+	struct ArenaMesh meshes[CHUNK_SECTIONS]; // mesh of each section of the chunk (packed vertices, see mesh_builder.h), the water only uses the first
+
+	uint8_t dirtySections; // bit per section whose mesh is out of date because of edits (see remesh_dirty_sections)
+	bool cullingDirty; // whether its blocks were edited since its culling data was worked out
+
+	// surrounding chunks, NULL if there isn't one (edge of the world)
+	struct Chunk* leftChunk;   // x - 1
+	struct Chunk* rightChunk;  // x + 1
+	struct Chunk* topChunk;    // z + 1
+	struct Chunk* bottomChunk; // z - 1
 };
 
-// inserts a block into a chunk
-void insert_block(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, vec4 block);
+// sets up a chunk at a position with all air blocks and no mesh
+void init_chunk(struct Chunk* chunk, vec2 position);
+
+// marks a built mesh with the chunk's slot (its index in the loaded chunks) and uploads each of its sections into the space
+// of that section in the mesh arena, which makes them up to date again (main thread only)
+void upload_chunk_mesh(struct Chunk* chunk, int slot, struct MeshBuilder* builder);
+
+// marks the sections whose meshes a changed block affects as dirty, the one its in, the one above or below if its on the edge
+// of its section, and the same section of the surrounding chunk its on the border of, if there is one
+void mark_block_dirty(struct Chunk* chunk, int xPos, int yPos, int zPos);
 
-// generates a chunk
-struct Chunk generate_chunk(vec2 position, int world_size, bool water);
+// inserts a block into a chunk and marks the sections it affects as dirty, nothing is rebuilt until remesh_dirty_sections
+void insert_block(struct Chunk* chunk, vec4 block);
 
-// optimize the chunks to remove internal faces
-void handle_chunk_sides(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk);
+// rebuilds the dirty sections of a chunk with the normal mesher (and its culling data if its blocks were edited)
+// (slot is the chunk's index in the loaded chunks)
+void remesh_dirty_sections(struct Chunk* chunk, int slot);
 
-// draw a chunk
+// generates the water, a single side for every chunk of a world_size x world_size world
+struct Chunk generate_water_chunk(vec2 position, int world_size);
+
+// rebuilds the chunk mesh with its linked surrounding chunks taken into account, removing faces hidden by them
+// (slot is the chunk's index in the loaded chunks)
+void handle_chunk_sides(struct Chunk* chunk, int slot);
+
+// draws a chunk on its own (only the water, whose vertices are in slots of their own, offset by its position)
 void draw_chunk(struct Chunk chunk, unsigned int shaderProgram, unsigned int worldAtlas, bool water, bool drawingWater);
 
+// sets up the block tile table and texture units of the vertex pulling shader (once, after creating it)
+void init_pull_shader(unsigned int shaderProgram);
+
+// draws count of the chunkCount loaded chunks (indices into chunks) with a single draw call, the ones meshed into face records
+// get drawn with the vertex pulling shader
+void draw_chunks(struct Chunk* chunks, int chunkCount, int* indices, int count, unsigned int shaderProgram, unsigned int pullShaderProgram, unsigned int worldAtlas, bool drawingWater);
+
 #endif
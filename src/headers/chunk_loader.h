@@ -0,0 +1,44 @@
+#ifndef CHUNK_LOADER_H
+#define CHUNK_LOADER_H
+
+#include "chunk.h"
+#include "mesh_builder.h"
+
+// handles a mesh built for a chunk by the workers on the main thread, along with the chunk's slot (its index in the loaded
+// chunks), the renderer uploads it, NULL just drops it
+typedef void (*ChunkMeshHandler)(struct Chunk* chunk, int slot, struct MeshBuilder* builder);
+
+// sets up a ringSize x ringSize buffer of chunks, that either streams around a centre chunk (ringSize has to be odd then),
+// or holds a fixed grid of chunks starting at 0, 0, nothing gets loaded until update_chunk_loader is called
+void init_chunk_loader(int ringSize, bool streaming, int centreX, int centreY, ChunkMeshHandler meshHandler);
+
+// moves the centre that the loaded chunks stream around (does nothing for a fixed grid)
+void set_chunk_loader_centre(int xPos, int yPos);
+
+// loads in the chunks that came into range, and hands up to maxMeshes finished meshes to the mesh handler (main thread)
+void update_chunk_loader(int maxMeshes);
+
+// gets the chunk object based on the snapped chunks position
+struct Chunk* get_chunk(int xPos, int yPos);
+
+// gets the index of a chunk based on the snapped chunks position
+int get_chunk_index(int xPos, int yPos);
+
+// works out the chunk coordinates that belong in a slot of the chunks buffer (which the chunk in it switches over to,
+// if it hasn't already, once its no longer in use)
+void get_slot_chunk_pos(int slot, int* xPos, int* yPos);
+
+// whether or not a chunk's blocks are being used by a worker thread (in which case they must not be changed)
+bool is_chunk_in_use(struct Chunk* chunk);
+
+// whether or not a chunk has been generated and meshed, and isn't being worked on
+bool is_chunk_ready(struct Chunk* chunk);
+
+// getters for the buffer of chunks (indices stay the same until the loader is terminated)
+struct Chunk* get_loaded_chunks();
+int get_loaded_chunk_count();
+
+// frees the chunks (the workers have to be done with them first)
+void terminate_chunk_loader();
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef CHUNK_MAP_H
+#define CHUNK_MAP_H
+
+#include <stdbool.h>
+
+#include "chunk.h"
+
+// a single slot of the chunk map
+struct ChunkMapEntry {
+	int x; // chunk coordinates the slot is keyed by
+	int z;
+
+	struct Chunk* chunk; // NULL if the slot is empty
+};
+
+// hash map from integer chunk coordinates to chunks (open addressing with linear probing)
+struct ChunkMap {
+	struct ChunkMapEntry* entries;
+	int count; // amount of chunks in the map
+	int capacity; // amount of slots (always a power of two)
+};
+
+// initiates an empty chunk map sized to hold at least the given amount of chunks without growing
+void init_chunk_map(struct ChunkMap* map, int chunkAmount);
+
+// gets the chunk at the given chunk coordinates, NULL if there isn't one
+struct Chunk* chunk_map_get(struct ChunkMap* map, int x, int z);
+
+// puts a chunk into the map at the given chunk coordinates, replacing whatever was there before
+void chunk_map_insert(struct ChunkMap* map, int x, int z, struct Chunk* chunk);
+
+// removes the chunk at the given chunk coordinates from the map (does nothing if there isn't one)
+void chunk_map_remove(struct ChunkMap* map, int x, int z);
+
+// frees the memory held by a chunk map (the chunks themselves aren't touched)
+void free_chunk_map(struct ChunkMap* map);
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef CULLING_H
+#define CULLING_H
+
+#include "../include/CGLM/cglm.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "chunk.h"
+#include "raycast.h"
+
+// sorts the indices of count chunk positions from nearest to furthest from a centre chunk (by squared distance in chunks)
+// into order, in linear time (count can't be more than MAX_CHUNK_SLOTS)
+void sort_chunks_by_distance(int (*positions)[2], int count, int centreX, int centreZ, int* order);
+
+// writes the indices out of order of the chunks whose bounding boxes are at least partly inside the view frustum
+// of viewProj (projection * view * model) to visible, keeping their order, returns how many were written
+int cull_chunks_frustum(mat4 viewProj, struct Chunk* chunks, int* order, int count, int* visible);
+
+// gets the bit of a chunk's face connections that says whether or not two different faces (BlockFace) are connected
+int get_face_pair_bit(int faceA, int faceB);
+
+// works out which pairs of a chunk's faces are connected thru its non solid blocks, by flood filling them
+// (needs redoing whenever its blocks change)
+uint16_t calc_chunk_face_connections(struct Chunk* chunk);
+
+// works out everything culling needs from a chunk's blocks, its face connections and occluders (see occlusion.h)
+// (needs redoing whenever its blocks change)
+void update_chunk_culling(struct Chunk* chunk);
+
+// works out which chunks could be seen from the camera thru the open faces of the chunks in between (cave culling), by walking
+// from the camera's chunk, only ever away from it, thru chunks that are in view (inView, per chunk index) and have the face
+// they're entered thru connected to the one they're left thru, the open air above the chunks is walked as well, chunks are
+// found with lookup within range chunks of the camera's chunk, the result goes into visible (per chunk index)
+void cull_chunks_caves(ChunkLookup lookup, struct Chunk* chunks, int range, int cameraX, int cameraZ, bool cameraAbove,
+	bool* inView, bool* visible);
+
+#endif
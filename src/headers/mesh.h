@@ -1,6 +1,17 @@
+#ifndef MESH_H
+#define MESH_H
+
 // mesh holds references to vao, vbo, ebo
 struct Mesh {
 	unsigned int vao;
 	unsigned int vbo;
 	unsigned int ebo;
 };
+
+// a mesh that lives in the shared mesh arena rather than buffers of its own (see mesh_arena.h), its just a handle to its
+// allocation there, so it stays valid when copied around or moved by defragmenting
+struct ArenaMesh {
+	int allocation; // -1 if nothing has been uploaded yet
+};
+
+#endif
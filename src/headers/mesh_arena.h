@@ -0,0 +1,42 @@
+#ifndef MESH_ARENA_H
+#define MESH_ARENA_H
+
+#include "mesh.h"
+#include "mesh_builder.h"
+
+// creates the vaos and the vertex and face record buffers every arena mesh gets sub-allocated out of, along with the static
+// quad index buffer they're all drawn with (faces are always 4 vertices in the same order, so meshes don't need any indices of their own)
+void init_mesh_arena();
+
+// uploads vertexCount packed vertices (see mesh_builder.h) into an arena mesh, replacing whatever was there before (reusing its
+// space if it still fits, otherwise making room for it, defragmenting or growing the arena if needed)
+void upload_arena_mesh(struct ArenaMesh* mesh, uint32_t* vertices, int vertexCount);
+
+// uploads faceCount face records (see mesh_builder.h) into an arena mesh, replacing whatever was there before, its faces
+// are drawn in the given chunk slot, they're read by the vertex pulling shader rather than as vertices (returns false, leaving
+// the mesh empty, if they don't fit because the face buffer is already as big as a texture buffer can be)
+bool upload_arena_faces(struct ArenaMesh* mesh, uint32_t* records, int faceCount, int slot);
+
+// gives the space of an arena mesh back to the arena
+void release_arena_mesh(struct ArenaMesh* mesh);
+
+// binds the vao of the vertex buffer of the arena, which the arena meshes uploaded as vertices are drawn with
+void bind_mesh_arena();
+
+// binds the vao of the face record buffer of the arena, along with the texture buffers the vertex pulling shader reads
+// (the face records on texture unit 1, the chunk slots of their pages on 2)
+void bind_face_arena();
+
+// gets the amount of faces an arena mesh draws
+int get_arena_mesh_faces(struct ArenaMesh* mesh);
+
+// draws a single arena mesh, if its in the bound buffer
+void draw_arena_mesh(struct ArenaMesh* mesh);
+
+// draws the ones of count arena meshes that are in the bound buffer with a single draw call
+void draw_arena_meshes(struct ArenaMesh** meshes, int count);
+
+// frees the buffers of the arena
+void terminate_mesh_arena();
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef MESH_BUILDER_H
+#define MESH_BUILDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// every vertex is packed into 2 32 bit words (decoded by block_shader.vert):
+//   word 0 - x (6 bits), y (6), z (6), side (3), corner (2), unused (1), chunk slot (8)
+//   word 1 - atlas tile (8 bits, column + row*16), width (6), height (6), mirrored (1), sink (8, in 1/256ths of a block)
+#define VERTEX_WORDS 2
+
+// where the chunk slot goes in the first word, its the index of the chunk's offset in the shader, filled in upon upload
+#define VERTEX_SLOT_SHIFT 24
+
+// most chunk slots the shader has offsets for
+#define MAX_CHUNK_SLOTS 128
+
+// when vertex pulling, every face is instead a single 32 bit record, which block_pull_shader.vert expands into its 4 corners:
+//   x (5 bits), y (5), z (5), side (3), block type (4, minus MIN_BLOCK_TYPE), width-1 (5), height-1 (5)
+// the texture of each side of each block type comes from a table in the shader (see create_block_tile_table)
+#define FACE_RECORD_TYPE_SHIFT 18
+#define FACE_RECORD_WIDTH_SHIFT 22
+#define FACE_RECORD_HEIGHT_SHIFT 27
+
+// most sections a mesh can be split up into (chunk meshes are built a section at a time, see build_chunk_sections)
+#define MAX_MESH_SECTIONS 8
+
+// growable cpu side staging buffer that meshes are built into before being uploaded in one go, only the vertices are built,
+// as every face is drawn with the same pattern of indices (see mesh_arena.h)
+struct MeshBuilder {
+	uint32_t* vertices; // vertex data (VERTEX_WORDS words per vertex, or a single face record per face if faceRecords is set)
+	int vertexCount; // amount of words written to vertices
+	int vertexCapacity; // amount of words allocated for vertices
+
+	bool faceRecords; // whether faces get written as face records (for vertex pulling) rather than vertices
+
+	int indexCount; // amount of indices the mesh is drawn with (6 per face, they all come from the shared quad index buffer)
+
+	int firstSection; // section the mesh starts at
+	int sectionCount; // amount of sections written one after the other, starting at firstSection
+	int sectionEnds[MAX_MESH_SECTIONS]; // amount of words written to vertices by the end of each section
+};
+
+// initiates an empty mesh builder (nothing is allocated until the first face is pushed)
+void init_mesh_builder(struct MeshBuilder* builder);
+
+// clears the contents of a mesh builder while keeping its allocated memory around for reuse (and whether it writes face records)
+void reset_mesh_builder(struct MeshBuilder* builder);
+
+// appends a single face (4 packed vertices, top left, top right, bottom left, bottom right) to the mesh builder
+void push_mesh_face(struct MeshBuilder* builder, uint32_t* sideVertices);
+
+// appends a single face record (for vertex pulling) to the mesh builder
+void push_face_record(struct MeshBuilder* builder, uint32_t record);
+
+// marks the end of the section that was being written to the mesh builder, the next faces go into the section after it
+void end_mesh_section(struct MeshBuilder* builder);
+
+// gets where a section of the mesh starts and how many words it holds in vertices (0 if it isn't in the mesh)
+void get_mesh_section(struct MeshBuilder* builder, int section, int* start, int* count);
+
+// frees the memory held by a mesh builder
+void free_mesh_builder(struct MeshBuilder* builder);
+
+#endif
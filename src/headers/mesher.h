@@ -0,0 +1,52 @@
+#ifndef MESHER_H
+#define MESHER_H
+
+#include "chunk.h"
+#include "mesh_builder.h"
+#include "blocks.h"
+
+// amount of words in the block tile table (one per side of every block type)
+#define BLOCK_TILE_TABLE_SIZE ((MAX_BLOCK_TYPE - MIN_BLOCK_TYPE + 1) * FACE_COUNT)
+
+// toggles greedy meshing of chunks (they have to be rebuilt for it to take effect)
+void toggle_greedy_meshing();
+
+// getter for whether or not greedy meshing is on
+bool get_greedy_meshing();
+
+// toggles meshing chunks into face records for vertex pulling, rather than vertices (they have to be rebuilt for it to take effect)
+void toggle_vertex_pulling();
+
+// getter for whether or not vertex pulling is on
+bool get_vertex_pulling();
+
+// creates the packed vertices of a side (a BlockFace) of a block type stretched across width x height blocks and writes them
+// to given array (4*VERTEX_WORDS words, see mesh_builder.h), the positions are within the chunk (0 to 32 along each axis)
+void create_side_vertices(int side, int blockType, int xPos, int yPos, int zPos, int width, int height, uint32_t* array);
+
+// packs a side of a block type stretched across width x height blocks into a single face record (see mesh_builder.h)
+uint32_t create_face_record(int side, int blockType, int xPos, int yPos, int zPos, int width, int height);
+
+// writes the atlas tile, mirroring and sink of every side of every block type into a table of BLOCK_TILE_TABLE_SIZE words,
+// which is what the vertex pulling shader looks the texture of a face record up in
+void create_block_tile_table(uint32_t* table);
+
+// meshes a chunk with a single face per visible block side, checking every block and its neighbours one at a time
+// (in a copy of which blocks are solid that's padded with the borders of the surrounding chunks, so seams need no special casing)
+void build_chunk_mesh_naive(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, struct MeshBuilder* builder);
+
+// meshes a chunk merging neighbouring visible sides of the same block type into rectangles (within each section)
+void build_chunk_mesh_greedy(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, struct MeshBuilder* builder);
+
+// meshes a chunk with a single face per visible block side, working out visibility a whole column at a time with bitmasks
+void build_chunk_mesh_binary(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, struct MeshBuilder* builder);
+
+// builds the mesh of the sections firstSection to lastSection of a chunk into a mesh builder with the currently selected mesher,
+// one section after the other (see get_mesh_section), as vertices or face records depending on whether vertex pulling is on
+// (NULL surrounding chunks are the edge of the world, the sides facing out of it are kept)
+void build_chunk_sections(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, int firstSection, int lastSection, struct MeshBuilder* builder);
+
+// builds the mesh of every section of a chunk into a mesh builder with the currently selected mesher
+void build_chunk_mesh(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, struct MeshBuilder* builder);
+
+#endif
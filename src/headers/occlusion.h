@@ -0,0 +1,53 @@
+#ifndef OCCLUSION_H
+#define OCCLUSION_H
+
+#include "../include/CGLM/cglm.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "chunk.h"
+
+// size of the depth buffer that occluders are drawn into (the pyramid above it halves this every level)
+#define OCCLUSION_WIDTH 256
+#define OCCLUSION_HEIGHT 144
+
+// amount of levels in the depth pyramid, the last one being a single texel
+#define OCCLUSION_LEVELS 9
+
+// occluders of a chunk tagged with the chunk's position, copied out of the chunk so they can be drawn on a worker thread
+// while the chunk itself is being edited
+struct OccluderChunk {
+	int x, z; // chunk coordinates
+
+	struct ChunkOccluders occluders;
+};
+
+// cpu side depth buffer with a hierarchical z pyramid on top, that chunk bounding boxes can be tested against
+// (depths are stored as 1/w, so bigger is nearer and 0 is nothing there)
+struct OcclusionBuffer {
+	float* levels[OCCLUSION_LEVELS]; // farthest depth in each texel, level 0 being the full size buffer
+	int widths[OCCLUSION_LEVELS];
+	int heights[OCCLUSION_LEVELS];
+
+	mat4 viewProj; // camera matrices the occluders were drawn with, the boxes are tested with the same ones
+	vec3 camPos;
+};
+
+// works out the occluders of a chunk (needs redoing whenever its blocks change)
+void calc_chunk_occluders(struct Chunk* chunk, struct ChunkOccluders* occluders);
+
+// allocates the depth buffer and its pyramid
+void init_occlusion_buffer(struct OcclusionBuffer* buffer);
+
+// clears the buffer and draws the occluders of count chunks into it as seen thru viewProj from camPos, then builds its pyramid
+// (only touches the buffer and the occluders, so its safe to run on a worker thread)
+void draw_occlusion_buffer(struct OcclusionBuffer* buffer, mat4 viewProj, vec3 camPos, struct OccluderChunk* chunks, int count);
+
+// whether or not a box is completely hidden behind the occluders drawn into the buffer
+bool is_box_occluded(struct OcclusionBuffer* buffer, vec3 boxMin, vec3 boxMax);
+
+// frees the depth buffer and its pyramid
+void free_occlusion_buffer(struct OcclusionBuffer* buffer);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef RAYCAST_H
+#define RAYCAST_H
+
+#include "../include/CGLM/cglm.h"
+
+#include "chunk.h"
+
+// looks up the chunk at a chunk position, returning NULL if there isn't one there
+typedef struct Chunk* (*ChunkLookup)(int xPos, int yPos);
+
+// steps a ray from origin along front until it reaches a block that isn't air, returns that block's type (0 if nothing was hit),
+// writes its position to hitPos (zeroed when nothing was hit) and the last air position before it to lastPos
+int cast_pointer_ray(ChunkLookup lookup, vec3 origin, vec3 front, vec3 hitPos, vec3 lastPos);
+
+#endif
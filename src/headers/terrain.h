@@ -0,0 +1,44 @@
+#ifndef TERRAIN_H
+#define TERRAIN_H
+
+#include "../include/CGLM/cglm.h"
+
+#include <stdint.h>
+
+#include "chunk.h"
+#include "block_writes.h"
+
+// spot within a chunk that a feature (a tree) grows from, found while filling in the terrain
+struct FeatureAnchor {
+	int x, y, z;
+};
+
+// scratch space that a chunk is generated in, carried over from the terrain phase to the decoration phase
+struct ChunkGenerator {
+	int8_t blockTypes[CHUNK_VOLUME]; // unpacked blocks of the chunk
+
+	struct FeatureAnchor anchors[CHUNK_LENGTH*CHUNK_WIDTH]; // at most one per column
+	int anchorCount;
+};
+
+// just returns the constant value of the water level float
+float get_water_level();
+
+// getter for the level that sand blocks go up to
+int get_sand_level();
+
+// calculates noise value as integer block y coordinate at given position, allows for offsetting with chunk coords
+int calc_chunk_noise_value(vec2 position, vec2 chunkOffset);
+
+// terrain phase, fills in the generator's blocks with the ground of a chunk and finds the anchors of its trees (safe to call from worker threads)
+void generate_chunk_terrain(struct Chunk* chunk, struct ChunkGenerator* generator);
+
+// decoration phase, grows the trees from the generator's anchors, blocks that land in surrounding chunks get appended to outgoing
+// (which can be NULL to drop them), the chunk's own blocks are left unpacked in the generator (safe to call from worker threads)
+void decorate_chunk(struct Chunk* chunk, struct ChunkGenerator* generator, struct BlockWrites* outgoing);
+
+// fills the blocks of a chunk with terrain and trees based on its position, dropping the parts of trees that spill over
+// into surrounding chunks (safe to call from worker threads)
+void generate_chunk_blocks(struct Chunk* chunk);
+
+#endif
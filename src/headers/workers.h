@@ -0,0 +1,25 @@
+#ifndef WORKERS_H
+#define WORKERS_H
+
+// function that a job runs, gets handed the data the job was submitted with
+typedef void (*WorkerFunction)(void* data);
+
+// starts up the worker threads (one per cpu core, leaving one for the main thread)
+void init_workers();
+
+// getter for the amount of worker threads
+int get_worker_count();
+
+// queues up a job, run is called on a worker thread and then finish on the main thread (so opengl calls go in finish, which can be NULL)
+void submit_worker_job(WorkerFunction run, WorkerFunction finish, void* data);
+
+// calls finish for up to maxJobs jobs that the workers are done with (main thread only), returns how many were finished
+int finish_worker_jobs(int maxJobs);
+
+// blocks until every submitted job has been run and finished (main thread only)
+void wait_for_worker_jobs();
+
+// stops and joins the worker threads, jobs still in the queue are dropped
+void terminate_workers();
+
+#endif
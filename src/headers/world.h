@@ -5,24 +5,45 @@
 #include "../include/GLFW/glfw3.h"
 
 #include "chunk.h"
+#include "chunk_loader.h"
 
 // toggles whether or not to draw water
 void toggle_drawing_water();
 
+// toggles whether or not to skip chunks that are hidden behind the chunks in between (prints how many it culled)
+void toggle_cave_culling();
+
+// getter for the percentage of the chunks in view that cave culling skipped last frame
+float get_cave_culled_percentage();
+
+// toggles whether or not to skip chunks that are hidden behind the ground in front of them (prints how many it culled)
+void toggle_occlusion_culling();
+
+// getter for the percentage of the chunks left over from cave culling that occlusion culling skipped last frame
+float get_occlusion_culled_percentage();
+
 // getter for world size
 int get_world_size();
 
 // getter for the value of the world atlas
 unsigned int get_world_atlas();
 
-// gets the chunk object based on the snapped chunks position
-struct Chunk* get_chunk(int xPos, int yPos);
+// rebuilds the dirty sections of every chunk that has any
+void remesh_dirty_chunks();
+
+// opens an edit batch, the blocks set until commit_edits are all applied at once (batches can be nested)
+void begin_edits();
+
+// records a block of the given type at a world block position in the open edit batch (outside of a batch its committed
+// straight away), writes into chunks that aren't loaded are dropped on commit
+void set_block_world(int xPos, int yPos, int zPos, int type);
 
-// gets the index of a chunk based on the snapped chunks position
-int get_chunk_index(int xPos, int yPos);
+// closes the open edit batch, the outermost commit applies every write and remeshes each touched chunk once, writes into
+// chunks the workers are busy with wait until they're free (a later frame), returns the amount of blocks changed right away
+int commit_edits();
 
-// sets an indexed chunk to an inserted chunk object
-void set_chunk(int index, struct Chunk* chunk);
+// rebuilds the meshes of all chunks in the world
+void remesh_world();
 
 // initiate world
 void init_world();
@@ -0,0 +1,26 @@
+#ifndef WORLD_RANDOM_H
+#define WORLD_RANDOM_H
+
+#include <stdint.h>
+
+// what a random number is used for, so that every use gets its own independent numbers
+enum RandomPurpose {
+	RANDOM_NOISE_OFFSET,   // the offset of the terrain noise (one per world)
+	RANDOM_TREE_PLACEMENT, // whether or not a column gets a tree
+	RANDOM_TREE_SHAPE      // log height and extra leaves of a tree
+};
+
+// sets the seed that the whole world is generated from (has to be done before any chunk is generated)
+void set_world_seed(uint32_t seed);
+
+// getter for the world seed
+uint32_t get_world_seed();
+
+// the counter'th random number for a purpose in a chunk, it only depends on the world seed and its arguments
+// (no hidden state), so it gives the same number on any thread, in any order, every time
+uint32_t get_chunk_random(int chunkX, int chunkZ, enum RandomPurpose purpose, uint32_t counter);
+
+// same as get_chunk_random, but as a float in between 0 (inclusive) and 1 (exclusive)
+float get_chunk_random_float(int chunkX, int chunkZ, enum RandomPurpose purpose, uint32_t counter);
+
+#endif
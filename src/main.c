@@ -6,6 +6,8 @@
 
 #include "headers/camera.h"
 #include "headers/world.h"
+#include "headers/chunk.h"
+#include "headers/mesher.h"
 #include "headers/pointer.h"
 #include "headers/menu.h"
 
@@ -161,6 +163,44 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
 
 	}
 
+	// KEY G - toggle greedy meshing
+	if(key == GLFW_KEY_G && action == GLFW_PRESS) {
+
+		// toggle greedy meshing
+		toggle_greedy_meshing();
+
+		// and rebuild the world with it
+		remesh_world();
+
+	}
+
+	// KEY B - toggle vertex pulling
+	if(key == GLFW_KEY_B && action == GLFW_PRESS) {
+
+		// toggle meshing into face records
+		toggle_vertex_pulling();
+
+		// and rebuild the world with it
+		remesh_world();
+
+	}
+
+	// KEY O - toggle cave culling
+	if(key == GLFW_KEY_O && action == GLFW_PRESS) {
+
+		// toggle cave culling (which prints how many chunks it culled)
+		toggle_cave_culling();
+
+	}
+
+	// KEY P - toggle occlusion culling
+	if(key == GLFW_KEY_P && action == GLFW_PRESS) {
+
+		// toggle occlusion culling (which prints how many chunks it culled)
+		toggle_occlusion_culling();
+
+	}
+
 	// KEY C - toggle camera zoom
 	if(key == GLFW_KEY_C && action == GLFW_PRESS) {
 		
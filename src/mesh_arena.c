@@ -0,0 +1,631 @@
+#include "../include/GLAD33/glad.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "headers/mesh.h"
+#include "headers/mesh_builder.h"
+#include "headers/mesh_arena.h"
+#include "headers/arena_allocator.h"
+
+// one big vertex buffer that every chunk mesh is sub-allocated out of, so they can all share a single vao and be drawn with
+// a single call, the space is handed out by a free list (see arena_allocator.h)
+//
+// meshes don't have any indices of their own, every face is 4 vertices in the same order, so they all get drawn with one
+// static buffer of 16 bit indices that repeats the same pattern for as many faces as 16 bits can reach, meshes that are
+// bigger than that are drawn in several batches, each with its base vertex moved along
+//
+// meshes built for vertex pulling go into a second buffer the same way, which holds a single face record per face instead
+// of 4 vertices, the shader reads them thru a texture buffer (gl_VertexID / 4 is the face, gl_VertexID % 4 the corner),
+// and finds the chunk slot of a face in a second texture buffer, that holds the slot of every ARENA_GRANULARITY faces
+
+
+// ---
+
+
+// settings
+
+// size of a packed vertex (in bytes)
+const int VERTEX_SIZE = VERTEX_WORDS * sizeof(uint32_t);
+
+// amount of vertices the arena starts off with room for
+// (about what the chunks around the camera and the water take up)
+const int ARENA_INITIAL_VERTICES = 1 << 20;
+
+// amount of face records the arena starts off with room for (the same amount of faces as the vertices)
+const int ARENA_INITIAL_FACES = 1 << 18;
+
+// amount of faces the shared quad index buffer covers (as many as 16 bit indices can reach)
+const int QUAD_BATCH_FACES = 65536 / 4;
+
+// meshes are handed out a bit more space than they need (rounded up to a multiple of this), so they can grow a little
+// with every edit without moving (face meshes are also given their chunk slot in pages of this many faces, which
+// block_pull_shader.vert has to agree on)
+const int ARENA_GRANULARITY = 64;
+
+// when making room, the arena grows until it would be at most this full afterwards
+const float ARENA_MAX_FULLNESS = 0.75f;
+
+
+// ---
+
+
+// a buffer that arena meshes are sub-allocated out of, either of vertices, or of face records
+struct ArenaBuffer {
+	unsigned int vao;
+	unsigned int buffer;
+	unsigned int texture; // texture buffer the face records are read thru (0 for vertices)
+
+	struct ArenaAllocator allocator; // space in the buffer (in elements)
+
+	int elementSize; // size of a vertex or face record (in bytes)
+	int elementVertices; // amount of vertices each element stands for (1 for vertices, 4 for face records)
+};
+
+// where an arena mesh is in the buffers
+struct ArenaAllocation {
+	bool used;
+	bool faceRecords; // whether its in the face buffer rather than the vertex buffer
+
+	int start;
+	int capacity;
+
+	int faceCount; // amount of faces that are actually drawn
+
+	int slot; // chunk slot of its faces (face records only)
+};
+
+// the two buffers of the arena
+struct ArenaBuffer vertexArena;
+struct ArenaBuffer faceArena;
+
+// the buffer that is currently bound, only the meshes in it get drawn
+struct ArenaBuffer* boundArena = NULL;
+
+// the shared quad index buffer, it never changes
+unsigned int quadEBO;
+
+// most face records the face arena can hold, as its read thru a texture buffer it can't grow past the biggest one
+// (rounded down to whole pages)
+int maxFaceRecords;
+
+// chunk slot of every page of ARENA_GRANULARITY face records, and the buffer and texture the shader reads them thru
+uint8_t* faceSlots = NULL;
+unsigned int faceSlotBuffer;
+unsigned int faceSlotTexture;
+
+// every allocation that was handed out, arena meshes hold indices into it
+struct ArenaAllocation* allocations = NULL;
+int allocationCount = 0;
+int allocationCapacity = 0;
+
+// scratch arrays for the draw call of draw_arena_meshes
+int arenaDrawCapacity = 0;
+GLsizei* arenaDrawCounts = NULL;
+void** arenaDrawOffsets = NULL;
+GLint* arenaDrawBaseVertices = NULL;
+
+
+// ---
+
+
+// creates a buffer for an arena of the given size (in elements), vertex buffers get the vao's vertex attributes pointed at them,
+// face buffers are read thru the arena's texture buffer instead, so they don't need any
+void create_arena_buffer(struct ArenaBuffer* arena, int capacity, unsigned int* buffer) {
+
+	glGenBuffers(1, buffer);
+
+	// bind vao
+	glBindVertexArray((*arena).vao);
+
+	// bind the buffer and size it (its filled in one mesh at a time)
+	glBindBuffer(GL_ARRAY_BUFFER, *buffer);
+	glBufferData(GL_ARRAY_BUFFER, (*arena).elementSize * capacity, NULL, GL_DYNAMIC_DRAW);
+
+	// vertex attributes
+	if((*arena).texture == 0) {
+
+		// packed vertex (decoded by the shader, see mesh_builder.h)
+		glVertexAttribIPointer(0, VERTEX_WORDS, GL_UNSIGNED_INT, VERTEX_SIZE, (void*)0);
+		glEnableVertexAttribArray(0);
+
+	}
+
+	// unbind vao
+	glBindVertexArray(0);
+
+	// unbind the buffer
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+}
+
+// creates the shared quad index buffer, every face gets the two triangles top left, top right, bottom left and
+// top right, bottom left, bottom right (see push_mesh_face)
+void create_quad_indices() {
+
+	uint16_t* indices = malloc(sizeof(uint16_t) * QUAD_BATCH_FACES * 6);
+
+	for(int i = 0; i < QUAD_BATCH_FACES; i++) {
+		uint16_t firstVertex = i * 4;
+
+		indices[i*6+0] = firstVertex;   indices[i*6+1] = firstVertex+1; indices[i*6+2] = firstVertex+2;
+		indices[i*6+3] = firstVertex+1; indices[i*6+4] = firstVertex+2; indices[i*6+5] = firstVertex+3;
+	}
+
+	glGenBuffers(1, &quadEBO);
+
+	// (bound thru a copy target, so it isn't bound to whatever vao is bound)
+	glBindBuffer(GL_COPY_WRITE_BUFFER, quadEBO);
+	glBufferData(GL_COPY_WRITE_BUFFER, sizeof(uint16_t) * QUAD_BATCH_FACES * 6, indices, GL_STATIC_DRAW);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	free(indices);
+
+}
+
+// sets up an arena buffer of the given size, with the quad index buffer bound to its vao
+void init_arena_buffer(struct ArenaBuffer* arena, int capacity, int elementSize, int elementVertices, bool faceRecords) {
+
+	(*arena).elementSize = elementSize;
+	(*arena).elementVertices = elementVertices;
+
+	glGenVertexArrays(1, &(*arena).vao);
+
+	// the ebo stays bound to the vao, so it never has to be bound again
+	glBindVertexArray((*arena).vao);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadEBO);
+	glBindVertexArray(0);
+
+	(*arena).texture = 0;
+
+	if(faceRecords) {
+		glGenTextures(1, &(*arena).texture);
+	}
+
+	create_arena_buffer(arena, capacity, &(*arena).buffer);
+
+	init_arena_allocator(&(*arena).allocator, capacity);
+
+}
+
+// points the texture buffers of the face arena at its current buffers, and uploads the slots of its pages
+void attach_face_textures() {
+
+	glBindTexture(GL_TEXTURE_BUFFER, faceArena.texture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, faceArena.buffer);
+
+	glBindBuffer(GL_TEXTURE_BUFFER, faceSlotBuffer);
+	glBufferData(GL_TEXTURE_BUFFER, faceArena.allocator.capacity / ARENA_GRANULARITY, faceSlots, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+	glBindTexture(GL_TEXTURE_BUFFER, faceSlotTexture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_R8UI, faceSlotBuffer);
+
+	glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+}
+
+// creates the vaos and buffers of the arena
+void init_mesh_arena() {
+
+	create_quad_indices();
+
+	// texture buffers only have to be 65536 texels big in opengl 3.3, most drivers go way past it
+	int maxTexels;
+	glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+
+	maxFaceRecords = maxTexels / ARENA_GRANULARITY * ARENA_GRANULARITY;
+
+	int initialFaces = ARENA_INITIAL_FACES < maxFaceRecords ? ARENA_INITIAL_FACES : maxFaceRecords;
+
+	init_arena_buffer(&vertexArena, ARENA_INITIAL_VERTICES, VERTEX_SIZE, 1, false);
+	init_arena_buffer(&faceArena, initialFaces, sizeof(uint32_t), 4, true);
+
+	// every page starts off in slot 0, only the pages of face meshes are ever read
+	faceSlots = calloc(initialFaces / ARENA_GRANULARITY, sizeof(uint8_t));
+
+	glGenBuffers(1, &faceSlotBuffer);
+	glGenTextures(1, &faceSlotTexture);
+
+	attach_face_textures();
+
+}
+
+
+// ---
+
+
+// sets the chunk slot of the pages of a face mesh
+void set_face_slots(struct ArenaAllocation* allocation) {
+	memset(faceSlots + (*allocation).start / ARENA_GRANULARITY, (*allocation).slot, (*allocation).capacity / ARENA_GRANULARITY);
+}
+
+// moves every mesh of an arena buffer to the start of a new buffer, one after the other, which gets rid of all the gaps between
+// them, the buffer is also grown until the extra elements fit without filling it past ARENA_MAX_FULLNESS (the face buffer
+// only up to maxFaceRecords)
+void defragment_mesh_arena(struct ArenaBuffer* arena, int extraElements) {
+
+	bool faceRecords = arena == &faceArena;
+
+	int capacity = (*arena).allocator.capacity;
+
+	while((*arena).allocator.used + extraElements > capacity * ARENA_MAX_FULLNESS && (!faceRecords || capacity < maxFaceRecords)) {
+		capacity *= 2;
+	}
+
+	if(faceRecords && capacity > maxFaceRecords) {
+		capacity = maxFaceRecords;
+	}
+
+	unsigned int newBuffer;
+	create_arena_buffer(arena, capacity, &newBuffer);
+
+	// hand all the space out again, in order
+	free_arena_allocator(&(*arena).allocator);
+	init_arena_allocator(&(*arena).allocator, capacity);
+
+	if(faceRecords) {
+		faceSlots = realloc(faceSlots, capacity / ARENA_GRANULARITY);
+	}
+
+	// and copy every mesh over to its new space on the gpu
+	glBindBuffer(GL_COPY_READ_BUFFER, (*arena).buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+
+	for(int i = 0; i < allocationCount; i++) {
+		struct ArenaAllocation* allocation = &allocations[i];
+
+		if(!(*allocation).used || (*allocation).faceRecords != faceRecords) {
+			continue;
+		}
+
+		int start = arena_allocate(&(*arena).allocator, (*allocation).capacity);
+
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+			(*arena).elementSize * (*allocation).start,
+			(*arena).elementSize * start,
+			(*arena).elementSize * (*allocation).capacity);
+
+		(*allocation).start = start;
+
+		if(faceRecords) {
+			set_face_slots(allocation);
+		}
+	}
+
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	// the old buffer isn't needed anymore
+	glDeleteBuffers(1, &(*arena).buffer);
+
+	(*arena).buffer = newBuffer;
+
+	// the textures have to be pointed at the new buffer
+	if(faceRecords) {
+		attach_face_textures();
+	}
+
+}
+
+
+// ---
+
+
+// gives the space of an arena mesh back to the arena
+void release_arena_mesh(struct ArenaMesh* mesh) {
+	if((*mesh).allocation == -1) {
+		return;
+	}
+
+	struct ArenaAllocation* allocation = &allocations[(*mesh).allocation];
+
+	struct ArenaBuffer* arena = (*allocation).faceRecords ? &faceArena : &vertexArena;
+
+	arena_release(&(*arena).allocator, (*allocation).start, (*allocation).capacity);
+
+	(*allocation).used = false;
+
+	(*mesh).allocation = -1;
+}
+
+// finds an unused allocation slot, growing the list of them if necessary
+int get_free_arena_allocation() {
+	for(int i = 0; i < allocationCount; i++) {
+		if(!allocations[i].used) {
+			return i;
+		}
+	}
+
+	// start off with a few, otherwise double it
+	if(allocationCount == allocationCapacity) {
+		allocationCapacity = allocationCapacity == 0 ? 64 : allocationCapacity * 2;
+		allocations = realloc(allocations, sizeof(struct ArenaAllocation) * allocationCapacity);
+	}
+
+	allocations[allocationCount].used = false;
+
+	return allocationCount++;
+}
+
+// makes sure an arena mesh has room for elementCount elements in one of the arena buffers, keeping the space it already has
+// if the elements fit in it, and it isn't much bigger than needed, returns its allocation (NULL if there are no elements, or
+// if the face buffer is full and can't grow any further, the mesh is left empty then)
+struct ArenaAllocation* place_arena_mesh(struct ArenaMesh* mesh, struct ArenaBuffer* arena, int elementCount) {
+
+	bool faceRecords = arena == &faceArena;
+
+	// nothing to draw, so it doesn't need any space
+	if(elementCount == 0) {
+		release_arena_mesh(mesh);
+		return NULL;
+	}
+
+	// keep the space it already has if the new mesh fits in it, and isn't much smaller
+	if((*mesh).allocation != -1) {
+		struct ArenaAllocation* allocation = &allocations[(*mesh).allocation];
+
+		bool fits = (*allocation).faceRecords == faceRecords && elementCount <= (*allocation).capacity;
+		bool wasteful = elementCount < (*allocation).capacity / 2;
+
+		if(!fits || wasteful) {
+			release_arena_mesh(mesh);
+		}
+	}
+
+	if((*mesh).allocation == -1) {
+
+		// a little more than it needs
+		int capacity = (elementCount + elementCount/8 + ARENA_GRANULARITY-1) / ARENA_GRANULARITY * ARENA_GRANULARITY;
+
+		int start = arena_allocate(&(*arena).allocator, capacity);
+
+		// out of space (or too fragmented), so move everything up against each other, growing the buffer if needed
+		if(start == -1) {
+			defragment_mesh_arena(arena, capacity);
+
+			start = arena_allocate(&(*arena).allocator, capacity);
+		}
+
+		// still doesn't fit (only happens once the face buffer is as big as a texture buffer can be)
+		if(start == -1) {
+			return NULL;
+		}
+
+		(*mesh).allocation = get_free_arena_allocation();
+
+		allocations[(*mesh).allocation] = (struct ArenaAllocation){ true, faceRecords, start, capacity, 0, -1 };
+
+	}
+
+	return &allocations[(*mesh).allocation];
+
+}
+
+// uploads elementCount elements into the space of an allocation in an arena buffer with a single call
+void write_arena_mesh(struct ArenaBuffer* arena, struct ArenaAllocation* allocation, uint32_t* data, int elementCount) {
+	glBindBuffer(GL_COPY_WRITE_BUFFER, (*arena).buffer);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, (*arena).elementSize * (*allocation).start, (*arena).elementSize * elementCount, data);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+// uploads packed vertices into an arena mesh, replacing whatever was there before
+void upload_arena_mesh(struct ArenaMesh* mesh, uint32_t* vertices, int vertexCount) {
+
+	struct ArenaAllocation* allocation = place_arena_mesh(mesh, &vertexArena, vertexCount);
+
+	if(allocation == NULL) {
+		return;
+	}
+
+	// there are no indices to upload, they all come from the quad index buffer
+	write_arena_mesh(&vertexArena, allocation, vertices, vertexCount);
+
+	(*allocation).faceCount = vertexCount / 4;
+
+}
+
+// uploads face records into an arena mesh, replacing whatever was there before, its faces are in the given chunk slot,
+// returns false if they didn't fit
+bool upload_arena_faces(struct ArenaMesh* mesh, uint32_t* records, int faceCount, int slot) {
+
+	struct ArenaAllocation* allocation = place_arena_mesh(mesh, &faceArena, faceCount);
+
+	// (an empty mesh doesn't need any space to begin with)
+	if(allocation == NULL) {
+		return faceCount == 0;
+	}
+
+	write_arena_mesh(&faceArena, allocation, records, faceCount);
+
+	(*allocation).faceCount = faceCount;
+
+	// the slot only has to be uploaded when it changed (it doesn't move along with the mesh, that's up to defragmenting)
+	if((*allocation).slot != slot) {
+		(*allocation).slot = slot;
+
+		set_face_slots(allocation);
+
+		glBindBuffer(GL_COPY_WRITE_BUFFER, faceSlotBuffer);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, (*allocation).start / ARENA_GRANULARITY, (*allocation).capacity / ARENA_GRANULARITY,
+			faceSlots + (*allocation).start / ARENA_GRANULARITY);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+
+	return true;
+
+}
+
+
+// ---
+
+
+// binds an arena buffer, along with its textures for face records (the face records on texture unit 1 and their slots on 2)
+void bind_arena_buffer(struct ArenaBuffer* arena) {
+	glBindVertexArray((*arena).vao);
+
+	if((*arena).texture != 0) {
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_BUFFER, (*arena).texture);
+
+		glActiveTexture(GL_TEXTURE2);
+		glBindTexture(GL_TEXTURE_BUFFER, faceSlotTexture);
+
+		glActiveTexture(GL_TEXTURE0);
+	}
+
+	boundArena = arena;
+}
+
+// binds the vertex buffer of the arena
+void bind_mesh_arena() {
+	bind_arena_buffer(&vertexArena);
+}
+
+// binds the face record buffer of the arena
+void bind_face_arena() {
+	bind_arena_buffer(&faceArena);
+}
+
+// gets the allocation of an arena mesh if its in the bound arena buffer (NULL otherwise)
+struct ArenaAllocation* get_bound_allocation(struct ArenaMesh* mesh) {
+	if((*mesh).allocation == -1 || allocations[(*mesh).allocation].faceRecords != (boundArena == &faceArena)) {
+		return NULL;
+	}
+
+	return &allocations[(*mesh).allocation];
+}
+
+// gets the amount of batches an arena mesh has to be drawn in (one per QUAD_BATCH_FACES faces)
+int get_arena_mesh_batches(struct ArenaAllocation* allocation) {
+	return ((*allocation).faceCount + QUAD_BATCH_FACES-1) / QUAD_BATCH_FACES;
+}
+
+// gets the amount of faces an arena mesh draws
+int get_arena_mesh_faces(struct ArenaMesh* mesh) {
+	return (*mesh).allocation == -1 ? 0 : allocations[(*mesh).allocation].faceCount;
+}
+
+// draws a single arena mesh
+void draw_arena_mesh(struct ArenaMesh* mesh) {
+	struct ArenaAllocation* allocation = get_bound_allocation(mesh);
+
+	if(allocation == NULL) {
+		return;
+	}
+
+	for(int batch = 0; batch < get_arena_mesh_batches(allocation); batch++) {
+		int faces = (*allocation).faceCount - batch*QUAD_BATCH_FACES;
+
+		if(faces > QUAD_BATCH_FACES) {
+			faces = QUAD_BATCH_FACES;
+		}
+
+		glDrawElementsBaseVertex(GL_TRIANGLES, faces * 6, GL_UNSIGNED_SHORT, (void*)0,
+			(*allocation).start * (*boundArena).elementVertices + batch*QUAD_BATCH_FACES*4);
+	}
+}
+
+// draws count arena meshes with a single draw call
+void draw_arena_meshes(struct ArenaMesh** meshes, int count) {
+
+	// work out how many draws it takes (nearly always one per mesh)
+	int drawCount = 0;
+
+	for(int i = 0; i < count; i++) {
+		struct ArenaAllocation* allocation = get_bound_allocation(meshes[i]);
+
+		if(allocation != NULL) {
+			drawCount += get_arena_mesh_batches(allocation);
+		}
+	}
+
+	// grow the scratch arrays if necessary
+	if(drawCount > arenaDrawCapacity) {
+		arenaDrawCapacity = drawCount;
+
+		arenaDrawCounts = realloc(arenaDrawCounts, sizeof(GLsizei) * drawCount);
+		arenaDrawOffsets = realloc(arenaDrawOffsets, sizeof(void*) * drawCount);
+		arenaDrawBaseVertices = realloc(arenaDrawBaseVertices, sizeof(GLint) * drawCount);
+	}
+
+	int draw = 0;
+
+	for(int i = 0; i < count; i++) {
+		struct ArenaAllocation* allocation = get_bound_allocation(meshes[i]);
+
+		if(allocation == NULL) {
+			continue;
+		}
+
+		for(int batch = 0; batch < get_arena_mesh_batches(allocation); batch++) {
+			int faces = (*allocation).faceCount - batch*QUAD_BATCH_FACES;
+
+			if(faces > QUAD_BATCH_FACES) {
+				faces = QUAD_BATCH_FACES;
+			}
+
+			// every draw starts at the start of the quad index buffer, only the base vertex moves
+			// (for face records, the vertices are only there as far as gl_VertexID is concerned)
+			arenaDrawCounts[draw] = faces * 6;
+			arenaDrawOffsets[draw] = (void*)0;
+			arenaDrawBaseVertices[draw] = (*allocation).start * (*boundArena).elementVertices + batch*QUAD_BATCH_FACES*4;
+
+			draw++;
+		}
+	}
+
+	if(drawCount > 0) {
+		glMultiDrawElementsBaseVertex(GL_TRIANGLES, arenaDrawCounts, GL_UNSIGNED_SHORT, (const void* const*)arenaDrawOffsets,
+			drawCount, arenaDrawBaseVertices);
+	}
+
+}
+
+
+// ---
+
+
+// frees an arena buffer
+void free_arena_buffer(struct ArenaBuffer* arena) {
+	glDeleteBuffers(1, &(*arena).buffer);
+	glDeleteVertexArrays(1, &(*arena).vao);
+
+	if((*arena).texture != 0) {
+		glDeleteTextures(1, &(*arena).texture);
+	}
+
+	free_arena_allocator(&(*arena).allocator);
+}
+
+// frees the buffers of the arena
+void terminate_mesh_arena() {
+	free_arena_buffer(&vertexArena);
+	free_arena_buffer(&faceArena);
+
+	glDeleteBuffers(1, &quadEBO);
+
+	glDeleteBuffers(1, &faceSlotBuffer);
+	glDeleteTextures(1, &faceSlotTexture);
+
+	free(faceSlots);
+	faceSlots = NULL;
+
+	boundArena = NULL;
+
+	free(allocations);
+	allocations = NULL;
+	allocationCount = 0;
+	allocationCapacity = 0;
+
+	free(arenaDrawCounts);
+	free(arenaDrawOffsets);
+	free(arenaDrawBaseVertices);
+	arenaDrawCounts = NULL;
+	arenaDrawOffsets = NULL;
+	arenaDrawBaseVertices = NULL;
+	arenaDrawCapacity = 0;
+}
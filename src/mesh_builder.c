@@ -0,0 +1,130 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "headers/mesh_builder.h"
+
+
+// ---
+
+
+// amount of faces the buffers are sized for upon the first allocation
+const int BUILDER_INITIAL_FACES = 1024;
+
+
+// ---
+
+
+// initiates an empty mesh builder
+void init_mesh_builder(struct MeshBuilder* builder) {
+	(*builder).vertices = NULL;
+	(*builder).vertexCount = 0;
+	(*builder).vertexCapacity = 0;
+
+	(*builder).faceRecords = false;
+
+	(*builder).indexCount = 0;
+
+	(*builder).firstSection = 0;
+	(*builder).sectionCount = 0;
+}
+
+
+// ---
+
+
+// clears the contents of a mesh builder while keeping its memory
+void reset_mesh_builder(struct MeshBuilder* builder) {
+	(*builder).vertexCount = 0;
+	(*builder).indexCount = 0;
+
+	(*builder).firstSection = 0;
+	(*builder).sectionCount = 0;
+}
+
+
+// ---
+
+
+// makes sure there is room for another face, doubling the buffer whenever it runs out of space
+void reserve_mesh_face(struct MeshBuilder* builder) {
+
+	// vertices
+	if((*builder).vertexCount + 4*VERTEX_WORDS > (*builder).vertexCapacity) {
+
+		// start off with the initial size, otherwise double it
+		int newCapacity = (*builder).vertexCapacity == 0 ? BUILDER_INITIAL_FACES * 4*VERTEX_WORDS : (*builder).vertexCapacity * 2;
+
+		(*builder).vertices = realloc((*builder).vertices, sizeof(uint32_t) * newCapacity);
+		(*builder).vertexCapacity = newCapacity;
+
+	}
+
+}
+
+
+// ---
+
+
+// appends a single face to the mesh builder
+void push_mesh_face(struct MeshBuilder* builder, uint32_t* sideVertices) {
+
+	// grow buffers if necessary
+	reserve_mesh_face(builder);
+
+	// copy over the vertices
+	memcpy((*builder).vertices + (*builder).vertexCount, sideVertices, sizeof(uint32_t) * 4*VERTEX_WORDS);
+	(*builder).vertexCount += 4*VERTEX_WORDS;
+
+	// its two triangles come from the shared quad index buffer
+	(*builder).indexCount += 6;
+
+}
+
+// appends a single face record to the mesh builder
+void push_face_record(struct MeshBuilder* builder, uint32_t record) {
+
+	// grow buffers if necessary (reserves room for a whole face of vertices, which is more than enough)
+	reserve_mesh_face(builder);
+
+	(*builder).vertices[(*builder).vertexCount] = record;
+	(*builder).vertexCount++;
+
+	// its still drawn as two triangles, with the quad indices
+	(*builder).indexCount += 6;
+
+}
+
+
+// ---
+
+
+// marks the end of the section that was being written to the mesh builder
+void end_mesh_section(struct MeshBuilder* builder) {
+	(*builder).sectionEnds[(*builder).sectionCount] = (*builder).vertexCount;
+	(*builder).sectionCount++;
+}
+
+// gets where a section of the mesh starts and how many words it holds in vertices
+void get_mesh_section(struct MeshBuilder* builder, int section, int* start, int* count) {
+	int index = section - (*builder).firstSection;
+
+	if(index < 0 || index >= (*builder).sectionCount) {
+		*start = 0;
+		*count = 0;
+		return;
+	}
+
+	*start = index == 0 ? 0 : (*builder).sectionEnds[index-1];
+	*count = (*builder).sectionEnds[index] - *start;
+}
+
+
+// ---
+
+
+// frees the memory held by a mesh builder
+void free_mesh_builder(struct MeshBuilder* builder) {
+	free((*builder).vertices);
+
+	init_mesh_builder(builder);
+}
@@ -0,0 +1,752 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "headers/chunk.h"
+#include "headers/blocks.h"
+#include "headers/mesh_builder.h"
+#include "headers/mesher.h"
+
+
+// ---
+
+
+// the bitmask mesher stores a whole column of blocks in one 32 bit integer
+#if CHUNK_HEIGHT > 32
+#error "CHUNK_HEIGHT must fit into the 32 bit column masks of build_chunk_mesh_binary"
+#endif
+
+// face records only have 5 bits for each position and size, and 4 for the block type
+#if CHUNK_WIDTH > 32 || CHUNK_LENGTH > 32
+#error "CHUNK_WIDTH and CHUNK_LENGTH must fit into the 5 bit positions of a face record"
+#endif
+
+#if MAX_BLOCK_TYPE - MIN_BLOCK_TYPE >= 16
+#error "block types must fit into the 4 bit block type of a face record"
+#endif
+
+// sections have to split the columns up evenly
+#if CHUNK_HEIGHT % SECTION_HEIGHT != 0
+#error "CHUNK_HEIGHT must be a multiple of SECTION_HEIGHT"
+#endif
+
+// and a mesh builder has to be able to hold all of them
+#if CHUNK_SECTIONS > MAX_MESH_SECTIONS
+#error "CHUNK_SECTIONS must fit into the sections of a mesh builder"
+#endif
+
+
+// ---
+
+
+// settings
+
+// amount of tiles in each row of the atlas
+const int ATLAS_TILES_WIDE = 16;
+
+// whether or not chunks are meshed greedily (merging neighbouring faces of the same type into bigger ones)
+bool greedyMeshing = false;
+
+// whether or not chunks are meshed into face records for vertex pulling, rather than vertices
+bool vertexPulling = false;
+
+
+// ---
+
+
+// direction each side faces towards (x, y, z)
+const int SIDE_NORMALS[6][3] = {
+	{  0,  0,  1 }, // front
+	{  0,  0, -1 }, // back
+	{ -1,  0,  0 }, // left
+	{  1,  0,  0 }, // right
+	{  0, -1,  0 }, // bottom
+	{  0,  1,  0 }, // top
+};
+
+// axis (0 = x, 1 = y, 2 = z) that the width of each side stretches along
+const int SIDE_WIDTH_AXES[] = { 0, 0, 2, 2, 0, 0 };
+
+// axis that the height of each side stretches along
+const int SIDE_HEIGHT_AXES[] = { 1, 1, 1, 1, 2, 2 };
+
+// template corners of each side (top left, top right, bot left, bot right)
+const int SIDE_CORNERS[6][4][3] = {
+	{ { 0, 1, 1 }, { 1, 1, 1 }, { 0, 0, 1 }, { 1, 0, 1 } }, // front
+	{ { 0, 1, 0 }, { 1, 1, 0 }, { 0, 0, 0 }, { 1, 0, 0 } }, // back
+	{ { 0, 1, 0 }, { 0, 1, 1 }, { 0, 0, 0 }, { 0, 0, 1 } }, // left
+	{ { 1, 1, 1 }, { 1, 1, 0 }, { 1, 0, 1 }, { 1, 0, 0 } }, // right
+	{ { 0, 0, 1 }, { 1, 0, 1 }, { 0, 0, 0 }, { 1, 0, 0 } }, // bottom
+	{ { 0, 1, 1 }, { 1, 1, 1 }, { 0, 1, 0 }, { 1, 1, 0 } }, // top
+};
+
+// (the shade of each side and the texture coordinates of each corner are looked up by the shader)
+
+
+// ---
+
+
+// toggles greedy meshing (chunks have to be rebuilt for it to take effect)
+void toggle_greedy_meshing() {
+	greedyMeshing = !greedyMeshing;
+}
+
+// getter for greedy meshing
+bool get_greedy_meshing() {
+	return greedyMeshing;
+}
+
+// toggles vertex pulling (chunks have to be rebuilt for it to take effect)
+void toggle_vertex_pulling() {
+	vertexPulling = !vertexPulling;
+}
+
+// getter for vertex pulling
+bool get_vertex_pulling() {
+	return vertexPulling;
+}
+
+
+// ---
+
+
+// creates a side vertices array from the side templates and the block registry based on inputted side, block type and coordinates,
+// and writes it to given array, the side is stretched across width x height blocks (1x1 for a single block face) with its texture
+// repeating on each block, every vertex is packed into VERTEX_WORDS words (see mesh_builder.h)
+void create_side_vertices(int side, int blockType, int xPos, int yPos, int zPos, int width, int height, uint32_t* array) {
+
+	// registry entry of the block type
+	const struct BlockInfo* info = get_block_info(blockType);
+
+	// the texture side of the vertices is the same for every corner
+	uint32_t texture = ((*info).tiles[side][0] + (*info).tiles[side][1]*ATLAS_TILES_WIDE) // atlas tile
+		| width << 8
+		| height << 14
+		| (((*info).mirroredFaces & FACE_BIT(side)) ? 1 : 0) << 20 // whether the texture is flipped horizontally
+		| (uint32_t)((*info).yOff * 256 + 0.5f) << 21; // how far the side is sunk down
+
+	// the axes the width and height of the side stretch along
+	int widthAxis = SIDE_WIDTH_AXES[side];
+	int heightAxis = SIDE_HEIGHT_AXES[side];
+
+
+	// ---
+
+
+	// size of the side along each axis (the axis it faces stays 1, its corners are all 0 or 1 along it anyway)
+	int scale[3] = { 1, 1, 1 };
+	scale[widthAxis] = width;
+	scale[heightAxis] = height;
+
+	// write out the corners, stretched across the size of the side, the shader works out their texture coordinates from which
+	// corner they are and the size of the side, and then wraps them back into the tile so the texture repeats on every block
+	for(int c=0; c < 4; c++) {
+		int x = SIDE_CORNERS[side][c][0]*scale[0] + xPos;
+		int y = SIDE_CORNERS[side][c][1]*scale[1] + yPos;
+		int z = SIDE_CORNERS[side][c][2]*scale[2] + zPos;
+
+		array[c*VERTEX_WORDS + 0] = x | y << 6 | z << 12 | side << 18 | c << 21;
+		array[c*VERTEX_WORDS + 1] = texture;
+	}
+
+}
+
+
+// packs a side stretched across width x height blocks into a single face record (see mesh_builder.h), all the shader
+// needs to expand it into its corners and look up its texture
+uint32_t create_face_record(int side, int blockType, int xPos, int yPos, int zPos, int width, int height) {
+	return xPos | yPos << 5 | zPos << 10 | side << 15
+		| (blockType - MIN_BLOCK_TYPE) << FACE_RECORD_TYPE_SHIFT
+		| (width-1) << FACE_RECORD_WIDTH_SHIFT
+		| (uint32_t)(height-1) << FACE_RECORD_HEIGHT_SHIFT;
+}
+
+// writes the texture of every side of every block type into a table of BLOCK_TILE_TABLE_SIZE words, for the shader to look
+// face records up in, each is its atlas tile (8 bits, column + row*16), mirrored (1) and sink (8, in 1/256ths of a block)
+void create_block_tile_table(uint32_t* table) {
+	for(int type = MIN_BLOCK_TYPE; type <= MAX_BLOCK_TYPE; type++) {
+
+		const struct BlockInfo* info = get_block_info(type);
+
+		for(int side = 0; side < FACE_COUNT; side++) {
+			table[(type - MIN_BLOCK_TYPE)*FACE_COUNT + side] = ((*info).tiles[side][0] + (*info).tiles[side][1]*ATLAS_TILES_WIDE)
+				| (((*info).mirroredFaces & FACE_BIT(side)) ? 1 : 0) << 8
+				| (uint32_t)((*info).yOff * 256 + 0.5f) << 9;
+		}
+
+	}
+}
+
+
+// ---
+
+
+// writes a side stretched across width x height blocks into a mesh builder, either as its vertices or as a face record
+void write_side(struct MeshBuilder* builder, int side, int blockType, int xPos, int yPos, int zPos, int width, int height) {
+
+	if((*builder).faceRecords) {
+		push_face_record(builder, create_face_record(side, blockType, xPos, yPos, zPos, width, height));
+		return;
+	}
+
+	// vertices of the side
+	uint32_t sideVertices[4*VERTEX_WORDS];
+
+	create_side_vertices(side, blockType, xPos, yPos, zPos, width, height, sideVertices);
+	push_mesh_face(builder, sideVertices);
+
+}
+
+
+// ---
+
+
+// the apron has a bit for every block of a column, plus one below it (the floor, always solid) and one above it (always air)
+#define APRON_BIT(y) ((uint64_t)1 << ((y)+1))
+
+// amount of columns along each side of the apron, the chunk's columns with a bordering row of the surrounding chunks around them
+#define APRON_WIDTH (CHUNK_WIDTH+2)
+#define APRON_LENGTH (CHUNK_LENGTH+2)
+
+// index of the column at x, z (from -1 to CHUNK_WIDTH and CHUNK_LENGTH) in the apron
+#define APRON_INDEX(x, z) (((z)+1)*APRON_WIDTH + (x)+1)
+
+// the apron holds CHUNK_HEIGHT+2 bits in each column
+#if CHUNK_HEIGHT+2 > 64
+#error "CHUNK_HEIGHT must fit into the 64 bit columns of the apron, with a bit left over on either end"
+#endif
+
+
+// ---
+
+
+// gets the bits that a section covers within a 32 bit column mask
+uint32_t get_section_bits(int section) {
+	return (uint32_t)( ((uint64_t)1 << SECTION_HEIGHT) - 1 ) << (section*SECTION_HEIGHT);
+}
+
+// sets the bits of the solid blocks along the bordering row of a surrounding chunk in the apron, for the sections firstSection
+// to lastSection (the row runs along z at x = fixed if alongZ, otherwise along x at z = fixed, and its columns sit at start,
+// start+stride, ... in the apron)
+void load_border_row(struct Chunk* neighbour, int fixed, bool alongZ, uint64_t* apron, int start, int stride, int firstSection, int lastSection) {
+
+	// no surrounding chunk is the edge of the world, which stays air so the sides facing out of the world are still there
+	if(neighbour == NULL) {
+		return;
+	}
+
+	int rowLength = alongZ ? CHUNK_LENGTH : CHUNK_WIDTH;
+
+	for(int section = firstSection; section <= lastSection; section++) {
+
+		int sectionType = get_section_type(neighbour, section);
+
+		// sections of a single type that isn't solid (air or water) leave the row as air
+		if(sectionType != SECTION_MIXED && !is_block_solid(sectionType)) {
+			continue;
+		}
+
+		// solid sections fill the whole row at once
+		if(sectionType != SECTION_MIXED) {
+			for(int i = 0; i < rowLength; i++) {
+				apron[start + i*stride] |= (uint64_t)get_section_bits(section) << 1;
+			}
+			continue;
+		}
+
+		// otherwise go thru the row block by block
+		for(int y = section*SECTION_HEIGHT; y < (section+1)*SECTION_HEIGHT; y++) {
+			for(int i = 0; i < rowLength; i++) {
+
+				int blockType = alongZ ? get_block_type(neighbour, fixed, y, i) : get_block_type(neighbour, i, y, fixed);
+
+				if(is_block_solid(blockType)) {
+					apron[start + i*stride] |= APRON_BIT(y);
+				}
+
+			}
+		}
+
+	}
+
+}
+
+// fills in the apron of a chunk, a copy of which blocks are solid (hide the sides next to them) padded by one block on every side,
+// APRON_WIDTH x APRON_LENGTH columns of 64 bit masks, with the bordering rows of the surrounding chunks (air if there isn't one,
+// as thats the edge of the world) and a solid floor below and air above, so every mesher can look up whether a side is hidden
+// the same way, whether or not its on the border of the chunk, without branching on it
+// (filled and bottomless get a 32 bit column mask of every block that has sides, and of every block that has no bottom side,
+// for CHUNK_WIDTH x CHUNK_LENGTH columns)
+// only the sections firstSection to lastSection, and the ones right above and below them, are loaded, as thats all they look at
+void load_chunk_apron(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, int firstSection, int lastSection, uint64_t* apron, uint32_t* filled, uint32_t* bottomless) {
+
+	int firstLoaded = firstSection > 0 ? firstSection-1 : 0;
+	int lastLoaded = lastSection < CHUNK_SECTIONS-1 ? lastSection+1 : CHUNK_SECTIONS-1;
+
+	// every column starts off as air with just the floor below it
+	for(int i = 0; i < APRON_WIDTH * APRON_LENGTH; i++) {
+		apron[i] = APRON_BIT(-1);
+	}
+	memset(filled, 0, sizeof(uint32_t) * CHUNK_WIDTH * CHUNK_LENGTH);
+	memset(bottomless, 0, sizeof(uint32_t) * CHUNK_WIDTH * CHUNK_LENGTH);
+
+	// load the chunk a section at a time
+	for(int section = firstLoaded; section <= lastLoaded; section++) {
+
+		int sectionType = get_section_type(chunk, section);
+
+		// air sections have nothing to load
+		if(sectionType == 0) {
+			continue;
+		}
+
+		// sections of a single type set their bits in every column at once, without going thru their blocks
+		if(sectionType != SECTION_MIXED) {
+
+			uint32_t sectionBits = get_section_bits(section);
+
+			const struct BlockInfo* info = get_block_info(sectionType);
+
+			for(int z = 0; z < CHUNK_LENGTH; z++) {
+				for(int x = 0; x < CHUNK_WIDTH; x++) {
+
+					if((*info).solid) {
+						apron[APRON_INDEX(x, z)] |= (uint64_t)sectionBits << 1;
+					}
+					filled[z*CHUNK_WIDTH + x] |= sectionBits;
+
+					if(!((*info).faces & FACE_BIT(FACE_BOTTOM))) {
+						bottomless[z*CHUNK_WIDTH + x] |= sectionBits;
+					}
+
+				}
+			}
+
+			continue;
+
+		}
+
+		// otherwise unpack the section, and go thru its blocks in the same order as they are stored
+		int8_t blockTypes[SECTION_VOLUME];
+		unpack_block_storage(&(*chunk).sections[section], blockTypes);
+
+		for(int y = 0; y < SECTION_HEIGHT; y++) {
+
+			int yPos = section*SECTION_HEIGHT + y;
+
+			for(int z = 0; z < CHUNK_LENGTH; z++) {
+				for(int x = 0; x < CHUNK_WIDTH; x++) {
+
+					const struct BlockInfo* info = get_block_info( blockTypes[y*CHUNK_WIDTH*CHUNK_LENGTH + z*CHUNK_LENGTH + x] );
+
+					if((*info).faces == 0) {
+						continue;
+					}
+
+					if((*info).solid) {
+						apron[APRON_INDEX(x, z)] |= APRON_BIT(yPos);
+					}
+					filled[z*CHUNK_WIDTH + x] |= (uint32_t)1 << yPos;
+
+					if(!((*info).faces & FACE_BIT(FACE_BOTTOM))) {
+						bottomless[z*CHUNK_WIDTH + x] |= (uint32_t)1 << yPos;
+					}
+
+				}
+			}
+
+		}
+
+	}
+
+	// load the bordering rows of the surrounding chunks (only the sides of the sections being built look at them)
+	load_border_row(leftChunk,   CHUNK_WIDTH-1,  true,  apron, APRON_INDEX(-1, 0),           APRON_WIDTH, firstSection, lastSection);
+	load_border_row(rightChunk,  0,              true,  apron, APRON_INDEX(CHUNK_WIDTH, 0),  APRON_WIDTH, firstSection, lastSection);
+	load_border_row(bottomChunk, CHUNK_LENGTH-1, false, apron, APRON_INDEX(0, -1),           1,           firstSection, lastSection);
+	load_border_row(topChunk,    0,              false, apron, APRON_INDEX(0, CHUNK_LENGTH), 1,           firstSection, lastSection);
+
+}
+
+// checks whether a side pointing towards the given position (from -1 to the size of the chunk along each axis) is hidden
+// by the block there, as far as the apron knows
+bool is_apron_solid(uint64_t* apron, int xPos, int yPos, int zPos) {
+	return (apron[APRON_INDEX(xPos, zPos)] & APRON_BIT(yPos)) != 0;
+}
+
+// works out the visible sides of the blocks of the column at x, z within columnBits (a bit per y) out of the masks that
+// load_chunk_apron filled in, and writes a 32 bit column mask for each side into sides (FACE_COUNT of them)
+void calc_column_sides(uint64_t* apron, uint32_t* filled, uint32_t* bottomless, int x, int z, uint32_t columnBits, uint32_t* sides) {
+
+	uint32_t column = filled[z*CHUNK_WIDTH + x] & columnBits;
+
+	// index of the column in the apron
+	int p = APRON_INDEX(x, z);
+
+	// a side is visible if the block is filled and the block next to it isn't solid (the apron's columns are
+	// one bit up from the chunk's)
+	sides[0] = column & ~(uint32_t)(apron[p + APRON_WIDTH] >> 1); // front
+	sides[1] = column & ~(uint32_t)(apron[p - APRON_WIDTH] >> 1); // back
+	sides[2] = column & ~(uint32_t)(apron[p - 1] >> 1);           // left
+	sides[3] = column & ~(uint32_t)(apron[p + 1] >> 1);           // right
+
+	// below and above are just the same column shifted, the floor below it keeps the bottom-most bottom hidden
+	// (water bottoms are never visible either)
+	sides[4] = column & ~bottomless[z*CHUNK_WIDTH + x] & ~(uint32_t)apron[p]; // bottom
+	sides[5] = column & ~(uint32_t)(apron[p] >> 2);                           // top
+
+}
+
+
+// ---
+
+
+// builds the mesh of the sections firstSection to lastSection of a chunk into a mesh builder (one after the other), with a
+// single face per visible block side
+void build_sections_naive(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, int firstSection, int lastSection, struct MeshBuilder* builder) {
+
+	// clear whatever was built before
+	reset_mesh_builder(builder);
+
+	(*builder).firstSection = firstSection;
+
+	// which blocks hide the sides next to them, including the bordering rows of the surrounding chunks
+	uint64_t apron[APRON_WIDTH * APRON_LENGTH];
+	uint32_t filled[CHUNK_WIDTH * CHUNK_LENGTH];
+	uint32_t bottomless[CHUNK_WIDTH * CHUNK_LENGTH];
+
+	load_chunk_apron(chunk, leftChunk, rightChunk, topChunk, bottomChunk, firstSection, lastSection, apron, filled, bottomless);
+
+	for(int section = firstSection; section <= lastSection; section++) {
+
+		// skip over air sections as a whole
+		if(get_section_type(chunk, section) == 0) {
+			end_mesh_section(builder);
+			continue;
+		}
+
+		// iterate thru all block positions of the section in the same order as they are stored
+		for(int yPos = section*SECTION_HEIGHT; yPos < (section+1)*SECTION_HEIGHT; yPos++) {
+			for(int zPos = 0; zPos < CHUNK_LENGTH; zPos++) {
+				for(int xPos = 0; xPos < CHUNK_WIDTH; xPos++) {
+
+					// get type of block
+					int blockType = get_block_type(chunk, xPos, yPos, zPos);
+
+					// sides that the block has (air blocks have none)
+					int faces = (*get_block_info(blockType)).faces;
+
+					if(faces == 0) {
+						continue;
+					}
+
+					// go thru every side it has, and write the ones that aren't hidden by the block they face
+					for(int side = 0; side < FACE_COUNT; side++) {
+						if((faces & FACE_BIT(side)) && !is_apron_solid(apron,
+							xPos+SIDE_NORMALS[side][0], yPos+SIDE_NORMALS[side][1], zPos+SIDE_NORMALS[side][2])) {
+
+							write_side(builder, side, blockType, xPos, yPos, zPos, 1, 1);
+						}
+					}
+
+				}
+			}
+		}
+
+		end_mesh_section(builder);
+
+	}
+
+}
+
+// builds the mesh of a whole chunk into a mesh builder with a single face per visible block side
+void build_chunk_mesh_naive(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, struct MeshBuilder* builder) {
+	build_sections_naive(chunk, leftChunk, rightChunk, topChunk, bottomChunk, 0, CHUNK_SECTIONS-1, builder);
+}
+
+
+// ---
+
+
+// builds the mesh of the sections firstSection to lastSection of a chunk into a mesh builder (one after the other), merging
+// neighbouring visible sides of the same block type that face the same way into rectangles, one slice of a section at a time
+// (so sides don't get merged across sections)
+void build_sections_greedy(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, int firstSection, int lastSection, struct MeshBuilder* builder) {
+
+	// clear whatever was built before
+	reset_mesh_builder(builder);
+
+	(*builder).firstSection = firstSection;
+
+	// size of a section along each axis
+	int size[3] = { CHUNK_WIDTH, SECTION_HEIGHT, CHUNK_LENGTH };
+
+	// size of the biggest slice of a section
+	int maskSize = CHUNK_WIDTH*SECTION_HEIGHT;
+	if(SECTION_HEIGHT*CHUNK_LENGTH > maskSize) {
+		maskSize = SECTION_HEIGHT*CHUNK_LENGTH;
+	}
+	if(CHUNK_WIDTH*CHUNK_LENGTH > maskSize) {
+		maskSize = CHUNK_WIDTH*CHUNK_LENGTH;
+	}
+
+	// mask of a single slice, holding the block type of each visible side (0 if there isn't one)
+	int mask[maskSize];
+
+	// which blocks hide the sides next to them, including the bordering rows of the surrounding chunks
+	uint64_t apron[APRON_WIDTH * APRON_LENGTH];
+	uint32_t filled[CHUNK_WIDTH * CHUNK_LENGTH];
+	uint32_t bottomless[CHUNK_WIDTH * CHUNK_LENGTH];
+
+	load_chunk_apron(chunk, leftChunk, rightChunk, topChunk, bottomChunk, firstSection, lastSection, apron, filled, bottomless);
+
+	// block types of the section being meshed, unpacked once instead of decoding every block of every slice
+	int8_t blockTypes[SECTION_VOLUME];
+
+	// column masks of the visible sides of the section being meshed, one per side
+	uint32_t sideColumns[FACE_COUNT][CHUNK_WIDTH * CHUNK_LENGTH];
+
+	for(int section = firstSection; section <= lastSection; section++) {
+
+		// air sections have no sides
+		if(get_section_type(chunk, section) == 0) {
+			end_mesh_section(builder);
+			continue;
+		}
+
+		unpack_block_storage(&(*chunk).sections[section], blockTypes);
+
+		// work out which sides of every block of the section are visible, the same way the binary mesher does
+		uint32_t sectionBits = get_section_bits(section);
+
+		for(int z = 0; z < CHUNK_LENGTH; z++) {
+			for(int x = 0; x < CHUNK_WIDTH; x++) {
+
+				uint32_t sides[FACE_COUNT];
+				calc_column_sides(apron, filled, bottomless, x, z, sectionBits, sides);
+
+				for(int side = 0; side < FACE_COUNT; side++) {
+					sideColumns[side][z*CHUNK_WIDTH + x] = sides[side];
+				}
+
+			}
+		}
+
+		// where the section starts along each axis
+		int origin[3] = { 0, section*SECTION_HEIGHT, 0 };
+
+		// go thru every side
+		for(int side = 0; side < FACE_COUNT; side++) {
+
+			// axes of the side
+			int widthAxis = SIDE_WIDTH_AXES[side];
+			int heightAxis = SIDE_HEIGHT_AXES[side];
+			int sliceAxis = 3 - widthAxis - heightAxis;
+
+			// size of a slice
+			int maskWidth = size[widthAxis];
+			int maskHeight = size[heightAxis];
+
+			// go thru every slice along the axis the side faces
+			for(int slice = 0; slice < size[sliceAxis]; slice++) {
+
+				// block position
+				int pos[3];
+				pos[sliceAxis] = origin[sliceAxis] + slice;
+
+				// whether the slice has any visible sides at all
+				bool sliceEmpty = true;
+
+				// fill in the mask
+				for(int v = 0; v < maskHeight; v++) {
+					for(int u = 0; u < maskWidth; u++) {
+
+						pos[widthAxis] = origin[widthAxis] + u;
+						pos[heightAxis] = origin[heightAxis] + v;
+
+						// no side if the block doesn't have one (air blocks, the bottoms of water blocks), or if its hidden
+						int blockType = 0;
+
+						if((sideColumns[side][pos[2]*CHUNK_WIDTH + pos[0]] >> pos[1]) & 1) {
+							blockType = blockTypes[(pos[1]-origin[1])*CHUNK_WIDTH*CHUNK_LENGTH + pos[2]*CHUNK_LENGTH + pos[0]];
+							sliceEmpty = false;
+						}
+
+						mask[v*maskWidth + u] = blockType;
+
+					}
+				}
+
+				// nothing to merge
+				if(sliceEmpty) {
+					continue;
+				}
+
+				// now merge the mask into rectangles
+				for(int v = 0; v < maskHeight; v++) {
+					for(int u = 0; u < maskWidth; ) {
+
+						int blockType = mask[v*maskWidth + u];
+
+						// skip empty spots
+						if(blockType == 0) {
+							u++;
+							continue;
+						}
+
+						// grow the rectangle along the width as far as the same type goes
+						int width = 1;
+						while(u+width < maskWidth && mask[v*maskWidth + u+width] == blockType) {
+							width++;
+						}
+
+						// then grow it along the height as long as whole rows match
+						int height = 1;
+						bool rowMatches = true;
+						while(v+height < maskHeight && rowMatches) {
+							for(int k = 0; k < width; k++) {
+								if(mask[(v+height)*maskWidth + u+k] != blockType) {
+									rowMatches = false;
+									break;
+								}
+							}
+
+							if(rowMatches) {
+								height++;
+							}
+						}
+
+						// clear the covered spots so they aren't meshed again
+						for(int h = 0; h < height; h++) {
+							for(int w = 0; w < width; w++) {
+								mask[(v+h)*maskWidth + u+w] = 0;
+							}
+						}
+
+						// generate the stretched side at the rectangle's starting block
+						pos[widthAxis] = origin[widthAxis] + u;
+						pos[heightAxis] = origin[heightAxis] + v;
+
+						write_side(builder, side, blockType, pos[0], pos[1], pos[2], width, height);
+
+						u += width;
+
+					}
+				}
+
+			}
+
+		}
+
+		end_mesh_section(builder);
+
+	}
+
+}
+
+// builds the mesh of a whole chunk into a mesh builder, merging neighbouring visible sides into rectangles
+void build_chunk_mesh_greedy(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, struct MeshBuilder* builder) {
+	build_sections_greedy(chunk, leftChunk, rightChunk, topChunk, bottomChunk, 0, CHUNK_SECTIONS-1, builder);
+}
+
+
+// ---
+
+
+// builds the mesh of the sections firstSection to lastSection of a chunk into a mesh builder (one after the other) using
+// bitmasks, each column of the chunk is stored as a single integer with one bit per block, so the visible sides of a whole
+// column are found with a few shifts and ands, then only the set bits get walked thru to write the faces
+void build_sections_binary(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, int firstSection, int lastSection, struct MeshBuilder* builder) {
+
+	// clear whatever was built before
+	reset_mesh_builder(builder);
+
+	(*builder).firstSection = firstSection;
+
+	// bit set for every block that hides the sides next to it (anything but air and water), padded by one column on every side
+	// to hold the bordering columns of the surrounding chunks, and by a bit below and above every column (see load_chunk_apron)
+	uint64_t apron[APRON_WIDTH * APRON_LENGTH];
+
+	// bit set for every block that has sides (anything but air)
+	uint32_t filled[CHUNK_WIDTH * CHUNK_LENGTH];
+
+	// bit set for every block that has sides but no bottom side (water)
+	uint32_t bottomless[CHUNK_WIDTH * CHUNK_LENGTH];
+
+	load_chunk_apron(chunk, leftChunk, rightChunk, topChunk, bottomChunk, firstSection, lastSection, apron, filled, bottomless);
+
+
+	// ---
+
+
+	// now work out the visible sides of every column, a section at a time, so the faces of each section end up together
+	for(int section = firstSection; section <= lastSection; section++) {
+
+		uint32_t sectionBits = get_section_bits(section);
+
+		for(int z = 0; z < CHUNK_LENGTH; z++) {
+			for(int x = 0; x < CHUNK_WIDTH; x++) {
+
+				// skip columns of just air
+				if((filled[z*CHUNK_WIDTH + x] & sectionBits) == 0) {
+					continue;
+				}
+
+				uint32_t sides[FACE_COUNT];
+				calc_column_sides(apron, filled, bottomless, x, z, sectionBits, sides);
+
+				// walk thru the set bits of every side and write their faces
+				for(int side = 0; side < FACE_COUNT; side++) {
+
+					uint32_t bits = sides[side];
+
+					while(bits != 0) {
+
+						// lowest set bit is the y position
+						int y = __builtin_ctz(bits);
+
+						// clear it
+						bits &= bits - 1;
+
+						int blockType = get_block_type(chunk, x, y, z);
+
+						write_side(builder, side, blockType, x, y, z, 1, 1);
+
+					}
+
+				}
+
+			}
+		}
+
+		end_mesh_section(builder);
+
+	}
+
+}
+
+// builds the mesh of a whole chunk into a mesh builder using bitmasks
+void build_chunk_mesh_binary(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, struct MeshBuilder* builder) {
+	build_sections_binary(chunk, leftChunk, rightChunk, topChunk, bottomChunk, 0, CHUNK_SECTIONS-1, builder);
+}
+
+
+// ---
+
+
+// builds the mesh of the sections firstSection to lastSection of a chunk into a mesh builder with the currently selected mesher
+void build_chunk_sections(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, int firstSection, int lastSection, struct MeshBuilder* builder) {
+	(*builder).faceRecords = vertexPulling;
+
+	if(greedyMeshing) {
+		build_sections_greedy(chunk, leftChunk, rightChunk, topChunk, bottomChunk, firstSection, lastSection, builder);
+	}
+	else {
+		build_sections_binary(chunk, leftChunk, rightChunk, topChunk, bottomChunk, firstSection, lastSection, builder);
+	}
+}
+
+// builds the mesh of a chunk into a mesh builder, only writing the faces that are actually visible
+void build_chunk_mesh(struct Chunk* chunk, struct Chunk* leftChunk, struct Chunk* rightChunk, struct Chunk* topChunk, struct Chunk* bottomChunk, struct MeshBuilder* builder) {
+	build_chunk_sections(chunk, leftChunk, rightChunk, topChunk, bottomChunk, 0, CHUNK_SECTIONS-1, builder);
+}
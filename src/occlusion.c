@@ -0,0 +1,454 @@
+#include "../include/CGLM/cglm.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "headers/chunk.h"
+#include "headers/blocks.h"
+#include "headers/occlusion.h"
+
+// occlusion culling on the cpu, the solid ground and solid regions of the chunks near the camera are drawn as boxes into a small
+// depth buffer, and the bounding boxes of chunks are tested against a pyramid of its farthest depths, doesn't touch opengl
+// (the loops over texels are kept branch free and over contiguous floats, so the compiler can vectorize them)
+
+
+// ---
+
+
+// settings
+
+// corners of occluders closer to the camera than this (in w) stop the whole occluder from being drawn, the same goes for
+// boxes being tested, which then count as visible
+const float OCCLUSION_NEAR = 0.1f;
+
+// how much nearer an occluder has to be than a box to hide it, so boxes right against their own occluders don't hide themselves
+const float OCCLUSION_BIAS = 1e-5f;
+
+
+// ---
+
+
+// works out the occluders of a chunk
+void calc_chunk_occluders(struct Chunk* chunk, struct ChunkOccluders* occluders) {
+
+	int8_t blockTypes[CHUNK_VOLUME];
+
+	for(int section = 0; section < CHUNK_SECTIONS; section++) {
+		unpack_block_storage(&(*chunk).sections[section], blockTypes + section*SECTION_VOLUME);
+	}
+
+	// looking the types up in the registry once per type, rather than once per block
+	bool solidTypes[MAX_BLOCK_TYPE - MIN_BLOCK_TYPE + 1];
+
+	for(int type = MIN_BLOCK_TYPE; type <= MAX_BLOCK_TYPE; type++) {
+		solidTypes[type - MIN_BLOCK_TYPE] = is_block_solid(type);
+	}
+
+	memset(occluders, 0, sizeof(struct ChunkOccluders));
+
+	int columnsWide = CHUNK_WIDTH / OCCLUDER_SIZE;
+
+	for(int column = 0; column < OCCLUDER_COLUMNS; column++) {
+
+		int startX = (column % columnsWide) * OCCLUDER_SIZE;
+		int startZ = (column / columnsWide) * OCCLUDER_SIZE;
+
+		// the lowest solid height out of the columns of blocks in the area, so the box under it is completely solid
+		int groundHeight = CHUNK_HEIGHT;
+
+		// and whether or not each region above it is completely solid
+		bool solidLayers[CHUNK_HEIGHT / OCCLUDER_SIZE];
+
+		for(int layer = 0; layer < CHUNK_HEIGHT / OCCLUDER_SIZE; layer++) {
+			solidLayers[layer] = true;
+		}
+
+		for(int z = startZ; z < startZ + OCCLUDER_SIZE; z++) {
+			for(int x = startX; x < startX + OCCLUDER_SIZE; x++) {
+
+				int height = 0;
+
+				while(height < CHUNK_HEIGHT && solidTypes[blockTypes[get_block_index(x, height, z)] - MIN_BLOCK_TYPE]) {
+					height++;
+				}
+
+				groundHeight = glm_imin(groundHeight, height);
+
+				for(int y = height; y < CHUNK_HEIGHT; y++) {
+					int type = blockTypes[get_block_index(x, y, z)];
+
+					if(!solidTypes[type - MIN_BLOCK_TYPE]) {
+						solidLayers[y / OCCLUDER_SIZE] = false;
+					}
+
+					if(type != 0 && y+1 > (*occluders).topHeight) {
+						(*occluders).topHeight = y+1;
+					}
+				}
+
+				if(height > (*occluders).topHeight) {
+					(*occluders).topHeight = height;
+				}
+
+			}
+		}
+
+		(*occluders).groundHeights[column] = groundHeight;
+
+		// the regions the ground box already covers don't need their own
+		for(int layer = (groundHeight + OCCLUDER_SIZE-1) / OCCLUDER_SIZE; layer < CHUNK_HEIGHT / OCCLUDER_SIZE; layer++) {
+			if(solidLayers[layer]) {
+				(*occluders).solidRegions |= (uint64_t)1 << (layer*OCCLUDER_COLUMNS + column);
+			}
+		}
+
+	}
+
+}
+
+
+// ---
+
+
+// allocates the depth buffer and its pyramid
+void init_occlusion_buffer(struct OcclusionBuffer* buffer) {
+	int width = OCCLUSION_WIDTH;
+	int height = OCCLUSION_HEIGHT;
+
+	for(int level = 0; level < OCCLUSION_LEVELS; level++) {
+		(*buffer).widths[level] = width;
+		(*buffer).heights[level] = height;
+		(*buffer).levels[level] = calloc(width*height, sizeof(float));
+
+		// round up, so every texel of a level is covered by the one above
+		width = (width+1) / 2;
+		height = (height+1) / 2;
+	}
+
+	glm_mat4_identity((*buffer).viewProj);
+	glm_vec3_zero((*buffer).camPos);
+}
+
+// frees the depth buffer and its pyramid
+void free_occlusion_buffer(struct OcclusionBuffer* buffer) {
+	for(int level = 0; level < OCCLUSION_LEVELS; level++) {
+		free((*buffer).levels[level]);
+		(*buffer).levels[level] = NULL;
+	}
+}
+
+
+// ---
+
+
+// projects a point into the depth buffer, x and y in texels and z as 1/w, returns false if its too close to (or behind) the camera
+bool project_occlusion_point(mat4 viewProj, vec3 point, vec3 projected) {
+	vec4 clip;
+	glm_mat4_mulv(viewProj, (vec4){ point[0], point[1], point[2], 1.0f }, clip);
+
+	if(clip[3] < OCCLUSION_NEAR) {
+		return false;
+	}
+
+	float inverseW = 1.0f / clip[3];
+
+	projected[0] = (clip[0]*inverseW * 0.5f + 0.5f) * OCCLUSION_WIDTH;
+	projected[1] = (clip[1]*inverseW * 0.5f + 0.5f) * OCCLUSION_HEIGHT;
+	projected[2] = inverseW;
+
+	return true;
+}
+
+// draws a triangle of projected points into the full size depth buffer, keeping the nearest depth of every texel it covers
+// (texels count as covered when their centre is inside)
+void draw_occlusion_triangle(float* depth, vec3 a, vec3 b, vec3 c) {
+
+	// twice the signed area, the edge functions are divided by it so they're the weights of each corner
+	float area = (b[0]-a[0])*(c[1]-a[1]) - (b[1]-a[1])*(c[0]-a[0]);
+
+	if(fabsf(area) < 1e-6f) {
+		return;
+	}
+
+	float inverseArea = 1.0f / area;
+
+	// texels the triangle could cover
+	int minX = glm_imax((int)floorf(glm_min(a[0], glm_min(b[0], c[0]))), 0);
+	int maxX = glm_imin((int)ceilf(glm_max(a[0], glm_max(b[0], c[0]))), OCCLUSION_WIDTH-1);
+	int minY = glm_imax((int)floorf(glm_min(a[1], glm_min(b[1], c[1]))), 0);
+	int maxY = glm_imin((int)ceilf(glm_max(a[1], glm_max(b[1], c[1]))), OCCLUSION_HEIGHT-1);
+
+	if(minX > maxX || minY > maxY) {
+		return;
+	}
+
+	// how each corner's weight changes per texel along x and y, weight = stepX*x + stepY*y + start
+	float stepX[3] = { (b[1]-c[1])*inverseArea, (c[1]-a[1])*inverseArea, (a[1]-b[1])*inverseArea };
+	float stepY[3] = { (c[0]-b[0])*inverseArea, (a[0]-c[0])*inverseArea, (b[0]-a[0])*inverseArea };
+	float start[3] = {
+		(b[0]*c[1] - c[0]*b[1])*inverseArea,
+		(c[0]*a[1] - a[0]*c[1])*inverseArea,
+		(a[0]*b[1] - b[0]*a[1])*inverseArea
+	};
+
+	// and depth as a plane across the screen
+	float depthX = stepX[0]*a[2] + stepX[1]*b[2] + stepX[2]*c[2];
+	float depthY = stepY[0]*a[2] + stepY[1]*b[2] + stepY[2]*c[2];
+	float depthStart = start[0]*a[2] + start[1]*b[2] + start[2]*c[2];
+
+	// where each corner's weight crosses 0 along a row is a line down the screen as well, x = crossingY*y + crossingStart,
+	// the texels at or past it along x (or before it, if stepX is negative) are on the inside of its edge
+	float crossingY[3];
+	float crossingStart[3];
+
+	for(int i = 0; i < 3; i++) {
+		crossingY[i] = stepX[i] != 0 ? -stepY[i] / stepX[i] : 0;
+		crossingStart[i] = stepX[i] != 0 ? -start[i] / stepX[i] - 0.5f : 0; // texel centres are half a texel in
+	}
+
+	for(int y = minY; y <= maxY; y++) {
+
+		float centreY = y + 0.5f;
+
+		// the texels of the row inside the triangle, so only they get looked at rather than the whole width of the triangle
+		int startX = minX;
+		int endX = maxX;
+
+		for(int i = 0; i < 3; i++) {
+			// kept within the buffer before turning it into a texel, as nearly flat edges cross miles away
+			// (which also keeps it positive once moved up by one, so truncating rounds it down)
+			float crossing = glm_clamp(crossingY[i]*centreY + crossingStart[i], -1.0f, OCCLUSION_WIDTH);
+
+			if(stepX[i] > 0) {
+				startX = glm_imax(startX, OCCLUSION_WIDTH - (int)(OCCLUSION_WIDTH - crossing)); // rounded up
+			}
+			else if(stepX[i] < 0) {
+				endX = glm_imin(endX, (int)(crossing + 1.0f) - 1); // rounded down
+			}
+			else if(stepY[i]*centreY + start[i] < 0) {
+				endX = -1; // past a flat edge, so never inside along this row
+			}
+		}
+
+		float* texels = depth + y*OCCLUSION_WIDTH;
+
+		// 1/w is linear in screen space, so only nearer depths need keeping along the row
+		for(int x = startX; x <= endX; x++) {
+			float z = depthX*(x + 0.5f) + depthY*centreY + depthStart;
+
+			texels[x] = glm_max(texels[x], z);
+		}
+
+	}
+
+}
+
+// draws the sides of a box that face the camera into the full size depth buffer, out of the ones in the sides mask
+// (a bit per side, min x, max x, min y, max y, min z, max z), boxes that come too close to the camera are skipped
+void draw_occlusion_box(struct OcclusionBuffer* buffer, vec3 boxMin, vec3 boxMax, int sides) {
+
+	// corners, indexed by (x is max) | (y is max) << 1 | (z is max) << 2
+	vec3 corners[8];
+
+	for(int i = 0; i < 8; i++) {
+		vec3 corner = {
+			i & 1 ? boxMax[0] : boxMin[0],
+			i & 2 ? boxMax[1] : boxMin[1],
+			i & 4 ? boxMax[2] : boxMin[2]
+		};
+
+		if(!project_occlusion_point((*buffer).viewProj, corner, corners[i])) {
+			return;
+		}
+	}
+
+	// the corners of each side (min x, max x, min y, max y, min z, max z), going around it
+	static const int SIDES[6][4] = {
+		{ 0, 2, 6, 4 }, { 1, 3, 7, 5 },
+		{ 0, 1, 5, 4 }, { 2, 3, 7, 6 },
+		{ 0, 1, 3, 2 }, { 4, 5, 7, 6 }
+	};
+
+	for(int side = 0; side < 6; side++) {
+		int axis = side / 2;
+		bool maxSide = side % 2;
+
+		// only the sides the camera is in front of can be seen
+		bool facingCamera = maxSide ? (*buffer).camPos[axis] > boxMax[axis] : (*buffer).camPos[axis] < boxMin[axis];
+
+		if(!(sides & (1 << side)) || !facingCamera) {
+			continue;
+		}
+
+		const int* c = SIDES[side];
+
+		draw_occlusion_triangle((*buffer).levels[0], corners[c[0]], corners[c[1]], corners[c[2]]);
+		draw_occlusion_triangle((*buffer).levels[0], corners[c[0]], corners[c[2]], corners[c[3]]);
+	}
+
+}
+
+// fills in every level of the pyramid above the full size buffer with the farthest depth of the texels below it
+void build_occlusion_pyramid(struct OcclusionBuffer* buffer) {
+	for(int level = 1; level < OCCLUSION_LEVELS; level++) {
+
+		float* below = (*buffer).levels[level-1];
+		int belowWidth = (*buffer).widths[level-1];
+		int belowHeight = (*buffer).heights[level-1];
+
+		float* texels = (*buffer).levels[level];
+
+		for(int y = 0; y < (*buffer).heights[level]; y++) {
+
+			// odd sizes just use the last row or column twice
+			float* row0 = below + (2*y)*belowWidth;
+			float* row1 = below + glm_imin(2*y+1, belowHeight-1)*belowWidth;
+
+			for(int x = 0; x < (*buffer).widths[level]; x++) {
+				int x0 = 2*x;
+				int x1 = glm_imin(2*x+1, belowWidth-1);
+
+				texels[y*(*buffer).widths[level] + x] = glm_min(glm_min(row0[x0], row0[x1]), glm_min(row1[x0], row1[x1]));
+			}
+
+		}
+
+	}
+}
+
+// clears the buffer and draws the occluders of count chunks into it, then builds its pyramid
+void draw_occlusion_buffer(struct OcclusionBuffer* buffer, mat4 viewProj, vec3 camPos, struct OccluderChunk* chunks, int count) {
+
+	glm_mat4_copy(viewProj, (*buffer).viewProj);
+	glm_vec3_copy(camPos, (*buffer).camPos);
+
+	// nothing is hidden until something is drawn
+	memset((*buffer).levels[0], 0, sizeof(float) * OCCLUSION_WIDTH*OCCLUSION_HEIGHT);
+
+	int columnsWide = CHUNK_WIDTH / OCCLUDER_SIZE;
+	int columnsLong = CHUNK_LENGTH / OCCLUDER_SIZE;
+
+	for(int i = 0; i < count; i++) {
+
+		struct ChunkOccluders* occluders = &chunks[i].occluders;
+
+		float chunkX = chunks[i].x * CHUNK_WIDTH;
+		float chunkZ = chunks[i].z * CHUNK_LENGTH;
+
+		for(int column = 0; column < OCCLUDER_COLUMNS; column++) {
+
+			int columnX = column % columnsWide;
+			int columnZ = column / columnsWide;
+
+			float x = chunkX + columnX * OCCLUDER_SIZE;
+			float z = chunkZ + columnZ * OCCLUDER_SIZE;
+
+			int height = (*occluders).groundHeights[column];
+
+			// the solid ground, leaving out the sides that are completely covered up by the ground of the column next to it
+			// (most of them, which saves drawing over the same texels again and again)
+			if(height > 0) {
+				int sides = 0x3F;
+
+				if(columnX > 0 && (*occluders).groundHeights[column-1] >= height) {
+					sides &= ~(1 << 0);
+				}
+				if(columnX < columnsWide-1 && (*occluders).groundHeights[column+1] >= height) {
+					sides &= ~(1 << 1);
+				}
+				if(columnZ > 0 && (*occluders).groundHeights[column-columnsWide] >= height) {
+					sides &= ~(1 << 4);
+				}
+				if(columnZ < columnsLong-1 && (*occluders).groundHeights[column+columnsWide] >= height) {
+					sides &= ~(1 << 5);
+				}
+
+				draw_occlusion_box(buffer, (vec3){ x, 0, z }, (vec3){ x + OCCLUDER_SIZE, height, z + OCCLUDER_SIZE }, sides);
+			}
+
+			// and the solid regions above it
+			for(int layer = 0; layer < CHUNK_HEIGHT / OCCLUDER_SIZE; layer++) {
+				if((*occluders).solidRegions & ((uint64_t)1 << (layer*OCCLUDER_COLUMNS + column))) {
+					float y = layer * OCCLUDER_SIZE;
+
+					draw_occlusion_box(buffer, (vec3){ x, y, z }, (vec3){ x + OCCLUDER_SIZE, y + OCCLUDER_SIZE, z + OCCLUDER_SIZE }, 0x3F);
+				}
+			}
+
+		}
+
+	}
+
+	build_occlusion_pyramid(buffer);
+
+}
+
+
+// ---
+
+
+// whether or not a box is completely hidden behind the occluders drawn into the buffer
+bool is_box_occluded(struct OcclusionBuffer* buffer, vec3 boxMin, vec3 boxMax) {
+
+	// texels the box covers, and its nearest depth
+	float minX = OCCLUSION_WIDTH;
+	float maxX = 0;
+	float minY = OCCLUSION_HEIGHT;
+	float maxY = 0;
+	float nearest = 0;
+
+	for(int i = 0; i < 8; i++) {
+		vec3 corner = {
+			i & 1 ? boxMax[0] : boxMin[0],
+			i & 2 ? boxMax[1] : boxMin[1],
+			i & 4 ? boxMax[2] : boxMin[2]
+		};
+
+		vec3 projected;
+
+		// right up against (or around) the camera
+		if(!project_occlusion_point((*buffer).viewProj, corner, projected)) {
+			return false;
+		}
+
+		minX = glm_min(minX, projected[0]);
+		maxX = glm_max(maxX, projected[0]);
+		minY = glm_min(minY, projected[1]);
+		maxY = glm_max(maxY, projected[1]);
+		nearest = glm_max(nearest, projected[2]);
+	}
+
+	// off screen, which is up to the frustum culling
+	if(maxX < 0 || maxY < 0 || minX >= OCCLUSION_WIDTH || minY >= OCCLUSION_HEIGHT) {
+		return false;
+	}
+
+	int x0 = glm_imax((int)minX, 0);
+	int x1 = glm_imin((int)maxX, OCCLUSION_WIDTH-1);
+	int y0 = glm_imax((int)minY, 0);
+	int y1 = glm_imin((int)maxY, OCCLUSION_HEIGHT-1);
+
+	// go up the pyramid until the box only covers a couple of texels each way
+	int level = 0;
+
+	while(level < OCCLUSION_LEVELS-1 && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1)) {
+		level++;
+	}
+
+	float* texels = (*buffer).levels[level];
+	int width = (*buffer).widths[level];
+
+	// hidden if every texel it covers has something nearer than it all the way thru
+	for(int y = y0 >> level; y <= y1 >> level; y++) {
+		for(int x = x0 >> level; x <= x1 >> level; x++) {
+			if(texels[y*width + x] <= nearest + OCCLUSION_BIAS) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+
+}
@@ -5,11 +5,13 @@
 #include <stdlib.h>
 
 #include "headers/chunk.h"
+#include "headers/blocks.h"
 #include "headers/menu.h"
 #include "headers/world.h"
 #include "headers/camera.h"
 #include "headers/image.h"
 #include "headers/shader.h"
+#include "headers/raycast.h"
 
 
 // ---
@@ -27,13 +29,6 @@ unsigned int selectShaderProgram;
 // crosshair shader program
 unsigned int crosshairShaderProgram;
 
-// how many blocks ahead can the pointer reach
-const int POINTER_REACH = 30;
-
-// divides the pointer incrementations by it, making the pointer more accurate,
-// but it will also require a higher pointer reach, which may haev an effect on performance
-const int POINTER_REDUCER = 3;
-
 // select block position
 vec3 selectPos = GLM_VEC3_ZERO_INIT;
 
@@ -46,9 +41,6 @@ bool selectingSomething = false;
 // type of currently selected block
 int selectBlockType = 0;
 
-// pointer to currently selected chunk
-struct Chunk* selectChunk;
-
 
 // ---
 
@@ -176,12 +168,6 @@ void init_select_block() {
 	selectedBlockMesh.vbo = VBO;
 	selectedBlockMesh.ebo = EBO;
 
-
-	// ---
-	
-
-	// also allocate space for selectChunk on heap
-	selectChunk = malloc( sizeof(struct Chunk) );
 }
 
 
@@ -203,81 +189,11 @@ void update_select_block() {
 		(*camPos)[2]-0.5
 	}, adjustedCamPos );
 
-	// iterations to move pointer along a line
-	int iterations = 0;
-
-	// the type of the block being looked at
-	selectBlockType = 0;
-
-	// position of chunk that camera is in
-	vec2 playerChunkPos;
-
-	// select position relative to chunk
-	vec3 relativeSelectPos;
-
-	// initiate by copying over current camera position to select position
-	glm_vec3_copy(adjustedCamPos, selectPos);
-
-	while(iterations < POINTER_REACH) {
-		// get player chunk position
-		playerChunkPos[0] = floor( round(selectPos[0]) / get_chunk_width() );
-		playerChunkPos[1] = floor( round(selectPos[2]) / get_chunk_length() );
-
-		// get the current chunk
-		selectChunk = get_chunk(playerChunkPos[0], playerChunkPos[1]);
-
-		// if selected chunk isn't NULL (aka out of bounds)
-		if(selectChunk != NULL) {
-			// copy over selectPos to relativeSelectPos
-			glm_vec3_copy(selectPos, relativeSelectPos);
-
-			// remove chunk position 
-			relativeSelectPos[0] -= (*selectChunk).pos[0]*get_chunk_width();
-			relativeSelectPos[2] -= (*selectChunk).pos[1]*get_chunk_length();
-
-			// round the x y z values
-			relativeSelectPos[0] = round(relativeSelectPos[0]);
-			relativeSelectPos[1] = round(relativeSelectPos[1]);
-			relativeSelectPos[2] = round(relativeSelectPos[2]);
-
-			// if not out of y bounds (ABOVE OR BELOW CHUNK)
-			if(selectPos[1] > get_chunk_height() || selectPos[1] < 0) {
-				selectBlockType = 0;
-			}
-			else {
-				// get the block type of the block at that position
-				selectBlockType = get_block_type((*selectChunk).blockTypes, relativeSelectPos[0], relativeSelectPos[1], relativeSelectPos[2]);
-			}
-
-			// if block type is air, then move further along the path
-			if(selectBlockType == 0) {
-				// but before moving along path, copy to last select position
-				glm_vec3_copy(selectPos, lastSelectPos);
-				
-				// move along path
-				glm_vec3_add(selectPos, (vec3){
-					(*camFront)[0]/POINTER_REDUCER,
-					(*camFront)[1]/POINTER_REDUCER,
-					(*camFront)[2]/POINTER_REDUCER
-				}, selectPos);
-			}
-		}
-
-		// increment interations
-		iterations++;
-	}
+	// cast the pointer ray thru the world's chunks
+	selectBlockType = cast_pointer_ray(get_chunk, adjustedCamPos, *camFront, selectPos, lastSelectPos);
 
-	// if blocktype is still air by the end or selectPos y coordinate is above chunk height bounds,
-	// then just move the select position to 0, 0, 0 to avoid it being shown
-	if(selectBlockType == 0 || selectPos[1] >= get_chunk_height()-1) {
-		glm_vec3_copy(GLM_VEC3_ZERO, selectPos);
-		// set selectingSomething to false
-		selectingSomething = false;
-	}
-	else {
-		// enable selectingSomething
-		selectingSomething = true;
-	}
+	// only selecting something if the ray hit a block
+	selectingSomething = selectBlockType != 0;
 }
 
 
@@ -597,58 +513,27 @@ void draw_pointer(GLFWwindow* window, unsigned int worldAtlas) {
 // ---
 
 
-void place_block() {
+// sets the block at a world position to the given type, as an edit batch of its own (which rebuilds the chunks affected by it)
+void edit_block(vec3 position, int type) {
 
-	// if even selecting something in the first place
-	if(selectingSomething) {
-		// vector to store player chunk position
-		vec2 playerChunkPos = GLM_VEC2_ZERO_INIT;
-
-		// get player chunk position
-		playerChunkPos[0] = floor( round(lastSelectPos[0]) / get_chunk_width() );
-		playerChunkPos[1] = floor( round(lastSelectPos[2]) / get_chunk_length() );
-
-
-		// ---
-
-
-		// vector for relative position
-		vec3 relativeSelectPos;
+	begin_edits();
 
-		// copy over selectPos to relativeSelectPos
-		glm_vec3_copy(lastSelectPos, relativeSelectPos);
+	set_block_world(round(position[0]), round(position[1]), round(position[2]), type);
 
-		// remove chunk position 
-		relativeSelectPos[0] -= (*selectChunk).pos[0]*get_chunk_width();
-		relativeSelectPos[2] -= (*selectChunk).pos[1]*get_chunk_length();
+	commit_edits();
 
-		// round the x y z values
-		relativeSelectPos[0] = round(relativeSelectPos[0]);
-		relativeSelectPos[1] = round(relativeSelectPos[1]);
-		relativeSelectPos[2] = round(relativeSelectPos[2]);
-
-
-		// ---
-
-
-		// declare pointer to main chunk
-		struct Chunk* newChunk; 
-
-		// allocate space for new chunk pointer
-		newChunk = malloc( sizeof(struct Chunk) );
+}
 
-		// load main chunk to where newChunk pointer points
-		newChunk = get_chunk(playerChunkPos[0], playerChunkPos[1]);
 
-		// get index of that chunk
-		int index = get_chunk_index(playerChunkPos[0], playerChunkPos[1]);
+// ---
 
-		// insert block and process main main, surrounding chunks can be passed as NULL as when placing a block it wont matter
-		insert_block(newChunk, NULL, NULL, NULL, NULL,
-				(vec4){relativeSelectPos[0], relativeSelectPos[1], relativeSelectPos[2], get_selected_item()});
 
-		set_chunk(index, newChunk);
+void place_block() {
 
+	// if even selecting something in the first place
+	if(selectingSomething) {
+		// place selected block type at the position in front of the selected block
+		edit_block(lastSelectPos, get_selected_item());
 	}
 
 }
@@ -657,67 +542,8 @@ void delete_block() {
 
 	// if even selecting something in the first place
 	if(selectingSomething) {
-
-		// vector to store player chunk position
-		vec2 playerChunkPos = GLM_VEC2_ZERO_INIT;
-
-		// get player chunk position
-		playerChunkPos[0] = floor( round(selectPos[0]) / get_chunk_width() );
-		playerChunkPos[1] = floor( round(selectPos[2]) / get_chunk_length() );
-
-
-		// ---
-
-
-		// vector for relative position
-		vec3 relativeSelectPos;
-
-		// copy over selectPos to relativeSelectPos
-		glm_vec3_copy(selectPos, relativeSelectPos);
-
-		// remove chunk position 
-		relativeSelectPos[0] -= (*selectChunk).pos[0]*get_chunk_width();
-		relativeSelectPos[2] -= (*selectChunk).pos[1]*get_chunk_length();
-
-		// round the x y z values
-		relativeSelectPos[0] = round(relativeSelectPos[0]);
-		relativeSelectPos[1] = round(relativeSelectPos[1]);
-		relativeSelectPos[2] = round(relativeSelectPos[2]);
-
-
-		// ---
-
-
-		// declare necessary chunks for side handling
-		struct Chunk* newChunk = malloc( sizeof(struct Chunk) );; 
-
-		// side chunks, allocate space for them immediately
-		struct Chunk* leftChunk   = malloc( sizeof(struct Chunk) );
-		struct Chunk* rightChunk  = malloc( sizeof(struct Chunk) );
-		struct Chunk* topChunk    = malloc( sizeof(struct Chunk) );
-		struct Chunk* bottomChunk = malloc( sizeof(struct Chunk) );
-
-		// load main chunk to where newChunk pointer points
-		newChunk = get_chunk(playerChunkPos[0], playerChunkPos[1]);
-
-		// get the pointers to the chunks (if chunk not found then it just returns NULL)
-		leftChunk   = get_chunk(playerChunkPos[0]-1, playerChunkPos[1]);
-		rightChunk  = get_chunk(playerChunkPos[0]+1, playerChunkPos[1]);
-		topChunk    = get_chunk(playerChunkPos[0],   playerChunkPos[1]-1);
-		bottomChunk = get_chunk(playerChunkPos[0],   playerChunkPos[1]+1);
-
-		// indices for surrounding chunks
-		int leftIndex;
-		int rightIndex;
-		int topIndex;
-		int bottomIndex;
-
-		// get index of that chunk
-		int index = get_chunk_index(playerChunkPos[0], playerChunkPos[1]);
-
-		// insert block and process main+surrounding chunks to reflect the action
-		insert_block(newChunk, leftChunk, rightChunk, topChunk, bottomChunk, (vec4){relativeSelectPos[0], relativeSelectPos[1], relativeSelectPos[2], 0});
-
+		// replace selected block with air
+		edit_block(selectPos, 0);
 	}
 
 }
@@ -0,0 +1,177 @@
+#include "../include/CGLM/cglm.h"
+
+#include <math.h>
+
+#include "headers/chunk.h"
+#include "headers/blocks.h"
+#include "headers/raycast.h"
+
+// the pointer ray, it doesn't touch opengl or the camera, so it can be cast without a window
+
+
+// ---
+
+
+// settings
+
+// how many blocks ahead can the pointer reach
+const int POINTER_REACH = 30;
+
+// divides the pointer incrementations by it, making the pointer more accurate,
+// but it will also require a higher pointer reach, which may haev an effect on performance
+const int POINTER_REDUCER = 3;
+
+
+// ---
+
+
+// works out how many more pointer steps (of front/POINTER_REDUCER each) a position can take while staying inside a box
+// (the box is shrunk slightly, so it errs on the side of too few steps)
+int get_pointer_steps_in_box(vec3 position, vec3 front, vec3 boxMin, vec3 boxMax) {
+	int steps = POINTER_REACH;
+
+	for(int i = 0; i < 3; i++) {
+
+		float step = front[i] / POINTER_REDUCER;
+
+		// distance to the side of the box that the pointer is heading towards, in steps
+		float distance;
+
+		if(step > 0) {
+			distance = (boxMax[i] - 0.001f - position[i]) / step;
+		}
+		else if(step < 0) {
+			distance = (position[i] - (boxMin[i] + 0.001f)) / -step;
+		}
+		else {
+			continue; // never leaves along this axis
+		}
+
+		int axisSteps = distance > 0 ? (int)floor(distance) : 0;
+
+		if(axisSteps < steps) {
+			steps = axisSteps;
+		}
+
+	}
+
+	return steps;
+}
+
+
+// ---
+
+
+// steps a ray from origin along front until it reaches a block that isn't air, returns that block's type (0 if nothing was hit),
+// writes its position to hitPos (zeroed when nothing was hit) and the last air position before it to lastPos
+int cast_pointer_ray(ChunkLookup lookup, vec3 origin, vec3 front, vec3 hitPos, vec3 lastPos) {
+
+	// iterations to move pointer along a line
+	int iterations = 0;
+
+	// the type of the block being looked at
+	int blockType = 0;
+
+	// position of chunk that the pointer is in
+	vec2 chunkPos;
+
+	// the chunk that the pointer is in
+	struct Chunk* chunk;
+
+	// pointer position relative to chunk
+	vec3 relativePos;
+
+	// initiate by copying over the origin to the pointer position
+	glm_vec3_copy(origin, hitPos);
+
+	while(iterations < POINTER_REACH) {
+		// get chunk position
+		chunkPos[0] = floor( round(hitPos[0]) / CHUNK_WIDTH );
+		chunkPos[1] = floor( round(hitPos[2]) / CHUNK_LENGTH );
+
+		// get the current chunk
+		chunk = lookup(chunkPos[0], chunkPos[1]);
+
+		// if chunk isn't NULL (aka out of bounds)
+		if(chunk != NULL) {
+			// copy over hitPos to relativePos
+			glm_vec3_copy(hitPos, relativePos);
+
+			// remove chunk position
+			relativePos[0] -= (*chunk).pos[0]*CHUNK_WIDTH;
+			relativePos[2] -= (*chunk).pos[1]*CHUNK_LENGTH;
+
+			// round the x y z values
+			relativePos[0] = round(relativePos[0]);
+			relativePos[1] = round(relativePos[1]);
+			relativePos[2] = round(relativePos[2]);
+
+			// if not out of y bounds (ABOVE OR BELOW CHUNK)
+			if(relativePos[1] >= CHUNK_HEIGHT || relativePos[1] < 0) {
+				blockType = 0;
+			}
+			// if in an air section, skip straight thru it instead of looking at every block on the way
+			else if(get_section_type(chunk, relativePos[1] / SECTION_HEIGHT) == 0) {
+				blockType = 0;
+
+				// bounds of the section, in the same space as hitPos (blocks are rounded to, so they span -0.5 to +0.5)
+				int section = relativePos[1] / SECTION_HEIGHT;
+
+				vec3 sectionMin = {
+					(*chunk).pos[0]*CHUNK_WIDTH - 0.5f,
+					section*SECTION_HEIGHT - 0.5f,
+					(*chunk).pos[1]*CHUNK_LENGTH - 0.5f
+				};
+				vec3 sectionMax = {
+					sectionMin[0] + CHUNK_WIDTH,
+					sectionMin[1] + SECTION_HEIGHT,
+					sectionMin[2] + CHUNK_LENGTH
+				};
+
+				// take all the steps that stay within the section at once (keeping the last one for below, as usual)
+				int steps = get_pointer_steps_in_box(hitPos, front, sectionMin, sectionMax);
+
+				if(steps > POINTER_REACH-1 - iterations) {
+					steps = POINTER_REACH-1 - iterations;
+				}
+
+				if(steps > 0) {
+					glm_vec3_muladds(front, (float)steps / POINTER_REDUCER, hitPos);
+
+					iterations += steps;
+				}
+			}
+			else {
+				// get the block type of the block at that position
+				blockType = get_block_type(chunk, relativePos[0], relativePos[1], relativePos[2]);
+			}
+
+			// if block type is air, then move further along the path
+			if(blockType == 0) {
+				// but before moving along path, copy to last position
+				glm_vec3_copy(hitPos, lastPos);
+
+				// move along path
+				glm_vec3_add(hitPos, (vec3){
+					front[0]/POINTER_REDUCER,
+					front[1]/POINTER_REDUCER,
+					front[2]/POINTER_REDUCER
+				}, hitPos);
+			}
+		}
+
+		// increment interations
+		iterations++;
+	}
+
+	// if blocktype is still air by the end or the y coordinate is above chunk height bounds,
+	// then just move the hit position to 0, 0, 0 to avoid it being shown
+	if(blockType == 0 || hitPos[1] >= CHUNK_HEIGHT-1) {
+		glm_vec3_copy(GLM_VEC3_ZERO, hitPos);
+
+		return 0;
+	}
+
+	return blockType;
+
+}
@@ -0,0 +1,99 @@
+#version 330 core
+
+// vertex pulling, there are no vertex attributes, every face is a single 32 bit record in a texture buffer (see mesh_builder.h)
+//   x (5 bits), y (5), z (5), side (3), block type (4, minus MIN_BLOCK_TYPE), width-1 (5), height-1 (5)
+// which is expanded into its 4 corners, gl_VertexID / 4 is the face and gl_VertexID % 4 the corner
+uniform usamplerBuffer faceRecords;
+
+// chunk slot of every page of 64 faces (ARENA_GRANULARITY)
+uniform usamplerBuffer faceSlots;
+
+// texture of every side of every block type (BLOCK_TILE_TABLE_SIZE, see create_block_tile_table)
+//   atlas tile (8 bits, column + row*16), mirrored (1), sink (8, in 1/256ths of a block)
+uniform uint blockTiles[72];
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 proj;
+
+// offset of every chunk slot (MAX_CHUNK_SLOTS)
+uniform vec2 chunkOffsets[128];
+
+uniform float tide;
+
+out vec3 col;
+flat out vec2 tile;
+out vec2 texCoord;
+out vec3 worldPos;
+
+// shading value of each side
+const float SIDE_SHADES[6] = float[](0.9, 0.85, 0.75, 0.9, 0.7, 1.0);
+
+// texture coordinates of the corners of a side, in tiles relative to the top left corner of the tile
+const vec2 CORNER_TEX_COORDS[4] = vec2[](vec2(0, 0), vec2(1, 0), vec2(0, 1), vec2(1, 1));
+
+// template corners of each side (top left, top right, bot left, bot right), the same as in mesher.c
+const vec3 SIDE_CORNERS[24] = vec3[](
+	vec3(0, 1, 1), vec3(1, 1, 1), vec3(0, 0, 1), vec3(1, 0, 1), // front
+	vec3(0, 1, 0), vec3(1, 1, 0), vec3(0, 0, 0), vec3(1, 0, 0), // back
+	vec3(0, 1, 0), vec3(0, 1, 1), vec3(0, 0, 0), vec3(0, 0, 1), // left
+	vec3(1, 1, 1), vec3(1, 1, 0), vec3(1, 0, 1), vec3(1, 0, 0), // right
+	vec3(0, 0, 1), vec3(1, 0, 1), vec3(0, 0, 0), vec3(1, 0, 0), // bottom
+	vec3(0, 1, 1), vec3(1, 1, 1), vec3(0, 1, 0), vec3(1, 1, 0)  // top
+);
+
+// axes that the width and height of each side stretch along
+const int SIDE_WIDTH_AXES[6] = int[](0, 0, 2, 2, 0, 0);
+const int SIDE_HEIGHT_AXES[6] = int[](1, 1, 1, 1, 2, 2);
+
+float TILE_SIZE = 16.0;
+uint ATLAS_TILES_WIDE = 16u;
+
+int FACE_PAGE_SIZE = 64;
+
+void main() {
+	int face = gl_VertexID / 4;
+	int corner = gl_VertexID % 4;
+
+	uint record = texelFetch(faceRecords, face).r;
+	uint slot = texelFetch(faceSlots, face / FACE_PAGE_SIZE).r;
+
+	int side = int((record >> 15) & 7u);
+	uint blockType = (record >> 18) & 15u;
+	vec2 size = vec2(((record >> 22) & 31u) + 1u, (record >> 27) + 1u);
+
+	uint sideTexture = blockTiles[blockType * 6u + uint(side)];
+
+	uint tileIndex = sideTexture & 255u;
+	bool mirrored = ((sideTexture >> 8) & 1u) == 1u;
+	float sink = float((sideTexture >> 9) & 255u) / 256.0;
+
+	// stretch the template corner across the size of the side
+	vec3 scale = vec3(1.0);
+	scale[SIDE_WIDTH_AXES[side]] = size.x;
+	scale[SIDE_HEIGHT_AXES[side]] = size.y;
+
+	vec3 pos = vec3(record & 31u, (record >> 5) & 31u, (record >> 10) & 31u) + SIDE_CORNERS[side*4 + corner] * scale;
+
+	pos.xz += chunkOffsets[slot];
+	pos.y -= sink;
+
+	gl_Position = proj * view * model * vec4(pos.x, pos.y + tide, pos.z, 1.0);
+
+	col = vec3(SIDE_SHADES[side]);
+
+	// top left corner of the tile in the atlas (in pixels)
+	tile = vec2(tileIndex % ATLAS_TILES_WIDE, tileIndex / ATLAS_TILES_WIDE) * TILE_SIZE;
+
+	// stretched across the size of the side, flipped if the texture of the side is mirrored
+	vec2 cornerCoord = CORNER_TEX_COORDS[corner];
+
+	if(mirrored) {
+		cornerCoord.x = 1.0 - cornerCoord.x;
+	}
+
+	texCoord = cornerCoord * size;
+
+	// fog is worked out per fragment, as merged sides can be too big for it to be interpolated between vertices
+	worldPos = pos;
+}
@@ -3,25 +3,55 @@
 out vec4 FragColor;
 
 in vec3 col;
+flat in vec2 tile;
 in vec2 texCoord;
-in float opacity;
+in vec3 worldPos;
 
 uniform int underWater;
 
 uniform float shading;
 
+uniform vec3 camPos;
+
+uniform int fog;
+
 float waterR = 0.2;
 float waterG = 0.2;
 float waterB = 0.6;
 
+float OPACITY_MULTIPLIER = 3.0;
+
+float MAXIMUM_OPACITY_DISTANCE = 35.0;
+
+float ATLAS_SIZE = 256.0;
+float TILE_SIZE = 16.0;
+
 uniform sampler2D inTexture;
 
 void main() {
+	// wrap the texture coordinates back into the tile, so the texture repeats on every block of a merged side
+	vec2 atlasCoord = (tile + fract(texCoord) * TILE_SIZE) / ATLAS_SIZE;
+	atlasCoord.y = 1.0 - atlasCoord.y;
+
 	if(underWater == 1) {
-		FragColor = ( texture(inTexture, texCoord) * vec4(col, 1.0) ) * vec4(0.5, 0.5, 0.5, 1.0) * vec4(waterR, waterG, waterB, 1.0) * vec4(shading/255, shading/255, shading/255, 1.0) * 2;
+		FragColor = ( texture(inTexture, atlasCoord) * vec4(col, 1.0) ) * vec4(0.5, 0.5, 0.5, 1.0) * vec4(waterR, waterG, waterB, 1.0) * vec4(shading/255, shading/255, shading/255, 1.0) * 2;
 	}
 	else {
-		FragColor = texture(inTexture, texCoord) * vec4(col, 1.0) * vec4(shading/255, shading/255, shading/255, 1.0);
+		FragColor = texture(inTexture, atlasCoord) * vec4(col, 1.0) * vec4(shading/255, shading/255, shading/255, 1.0);
+	}
+
+	float opacity = 1.0;
+
+	if(fog == 1) {
+		float xOp = 1 - abs(camPos.x - worldPos.x) / MAXIMUM_OPACITY_DISTANCE;
+		float yOp = 1 - abs(camPos.y - worldPos.y) / MAXIMUM_OPACITY_DISTANCE;
+		float zOp = 1 - abs(camPos.z - worldPos.z) / MAXIMUM_OPACITY_DISTANCE;
+
+		opacity = (( xOp + yOp + zOp ) / 3) * OPACITY_MULTIPLIER;
+
+		if(opacity > 1.0) {
+			opacity = 1.0;
+		}
 	}
 
 	FragColor = FragColor * vec4(1.0, 1.0, 1.0, opacity);
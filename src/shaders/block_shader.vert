@@ -1,47 +1,64 @@
 #version 330 core
 
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aCol;
-layout (location = 2) in vec2 aTexCoord;
+// packed vertex, see mesh_builder.h
+//   x - x (6 bits), y (6), z (6), side (3), corner (2), unused (1), chunk slot (8)
+//   y - atlas tile (8 bits, column + row*16), width (6), height (6), mirrored (1), sink (8, in 1/256ths of a block)
+layout (location = 0) in uvec2 aVertex;
 
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 proj;
 
-uniform vec2 chunkOffset;
+// offset of every chunk slot (MAX_CHUNK_SLOTS)
+uniform vec2 chunkOffsets[128];
 
 uniform float tide;
 
-uniform vec3 camPos;
-
-uniform int fog;
-
 out vec3 col;
+flat out vec2 tile;
 out vec2 texCoord;
-out float opacity;
+out vec3 worldPos;
+
+// shading value of each side
+const float SIDE_SHADES[6] = float[](0.9, 0.85, 0.75, 0.9, 0.7, 1.0);
 
-float OPACITY_MULTIPLIER = 3.0;
+// texture coordinates of the corners of a side, in tiles relative to the top left corner of the tile
+const vec2 CORNER_TEX_COORDS[4] = vec2[](vec2(0, 0), vec2(1, 0), vec2(0, 1), vec2(1, 1));
 
-float MAXIMUM_OPACITY_DISTANCE = 35.0;
+float TILE_SIZE = 16.0;
+uint ATLAS_TILES_WIDE = 16u;
 
 void main() {
-	gl_Position = proj * view * model * vec4(aPos.x + chunkOffset.x, aPos.y + tide, aPos.z + chunkOffset.y, 1.0);
+	uint side = (aVertex.x >> 18) & 7u;
+	uint corner = (aVertex.x >> 21) & 3u;
+	uint slot = aVertex.x >> 24;
 
-	col = aCol;
-	texCoord = aTexCoord;
+	uint tileIndex = aVertex.y & 255u;
+	vec2 size = vec2((aVertex.y >> 8) & 63u, (aVertex.y >> 14) & 63u);
+	bool mirrored = ((aVertex.y >> 20) & 1u) == 1u;
+	float sink = float((aVertex.y >> 21) & 255u) / 256.0;
 
-	if(fog == 1) {
-		float xOp = 1 - abs(camPos.x - (aPos.x+chunkOffset.x)) / MAXIMUM_OPACITY_DISTANCE;
-		float yOp = 1 - abs(camPos.y - aPos.y) / MAXIMUM_OPACITY_DISTANCE;
-		float zOp = 1 - abs(camPos.z - (aPos.z+chunkOffset.y)) / MAXIMUM_OPACITY_DISTANCE;
+	vec3 pos = vec3(aVertex.x & 63u, (aVertex.x >> 6) & 63u, (aVertex.x >> 12) & 63u);
 
-		opacity = (( xOp + yOp + zOp ) / 3) * OPACITY_MULTIPLIER;
+	pos.xz += chunkOffsets[slot];
+	pos.y -= sink;
 
-		if(opacity > 1.0) {
-			opacity = 1.0;
-		}
-	}
-	else {
-		opacity = 1.0;
+	gl_Position = proj * view * model * vec4(pos.x, pos.y + tide, pos.z, 1.0);
+
+	col = vec3(SIDE_SHADES[side]);
+
+	// top left corner of the tile in the atlas (in pixels)
+	tile = vec2(tileIndex % ATLAS_TILES_WIDE, tileIndex / ATLAS_TILES_WIDE) * TILE_SIZE;
+
+	// stretched across the size of the side, flipped if the texture of the side is mirrored
+	vec2 cornerCoord = CORNER_TEX_COORDS[corner];
+
+	if(mirrored) {
+		cornerCoord.x = 1.0 - cornerCoord.x;
 	}
+
+	texCoord = cornerCoord * size;
+
+	// fog is worked out per fragment, as merged sides can be too big for it to be interpolated between vertices
+	worldPos = pos;
 }
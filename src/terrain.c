@@ -0,0 +1,352 @@
+#include "../include/CGLM/cglm.h"
+
+#include "../include/NOISE/noise1234.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "headers/chunk.h"
+#include "headers/blocks.h"
+#include "headers/terrain.h"
+#include "headers/world_random.h"
+#include "headers/block_writes.h"
+
+// terrain generation, doesn't touch opengl at all, so it runs on the worker threads (and without a window)
+
+
+// ---
+
+
+// settings
+
+// noise settings
+const int NOISE_ZOOM = 50;
+const int NOISE_HEIGHT_OFFSET = 15;
+
+// level at which stone blocks appear, coming from top
+const int STONE_LEVEL = 5;
+
+// level at which sand blocks appear, coming from bottom
+const int SAND_LEVEL = 10;
+
+// chance of a tree spawning on a grass block (ranges from 0.0f - 1.0f)
+const float CHANCE_OF_TREE = 0.005f;
+
+// maximum and minimum tree height in blocks
+const int MAX_TREE_HEIGHT = 6;
+const int MIN_TREE_HEIGHT = 5;
+
+// trees can only be placed TREE_BUFFER_LEVEL amount of blocks below STONE_LEVEL
+const int TREE_BUFFER_LEVEL = 4;
+
+// water level (this is purely for rendering some stuff when under the water level)
+const float CAM_WATER_LEVEL = SAND_LEVEL+0.5;
+
+// divide random noise offset value by this
+const float RAND_NOISE_DIVIDER = 2000;
+
+// amount of random numbers set aside for the shape of each tree (the most a tree can use is 2 + 3 per extra leaves block)
+const int TREE_RANDOM_COUNT = 64;
+
+
+// ---
+
+
+// works out the noise offset from the world seed (the same for every chunk)
+float get_noise_offset() {
+	return (get_chunk_random(0, 0, RANDOM_NOISE_OFFSET, 0) & 0x7fffffff) / RAND_NOISE_DIVIDER;
+}
+
+
+// ---
+
+
+// just returns the constant value of the camera water level float
+float get_water_level() {
+	return CAM_WATER_LEVEL;
+}
+
+// getter for the level that sand blocks go up to (the water plane sits just below it)
+int get_sand_level() {
+	return SAND_LEVEL;
+}
+
+
+// ---
+
+
+// calculates noise value as integer block y coordinate at given position, allows for offsetting with chunk coords
+int calc_chunk_noise_value(vec2 position, vec2 chunkOffset) {
+	float randomNoiseOffset = get_noise_offset();
+
+	return (int) ( 
+						noise2(
+							(float) ( position[0] + chunkOffset[0]*CHUNK_WIDTH + randomNoiseOffset ) / NOISE_ZOOM, 
+							(float) ( position[1] + chunkOffset[1]*CHUNK_LENGTH + randomNoiseOffset ) / NOISE_ZOOM
+						) * CHUNK_HEIGHT
+					 ) + NOISE_HEIGHT_OFFSET;
+}
+
+
+// ---
+
+
+// ---
+
+
+// works out the terrain height (the y of the top block) of every column of a chunk, capped to the chunk height
+void calc_chunk_heightmap(struct Chunk* chunk, int heightmap[CHUNK_LENGTH][CHUNK_WIDTH]) {
+	// noise coordinates of every column (the same as calc_chunk_noise_value works them out)
+	float noiseX[CHUNK_LENGTH*CHUNK_WIDTH];
+	float noiseY[CHUNK_LENGTH*CHUNK_WIDTH];
+
+	// and the noise values at them
+	float noiseValues[CHUNK_LENGTH*CHUNK_WIDTH];
+
+	float randomNoiseOffset = get_noise_offset();
+
+	for(int z = 0; z < CHUNK_LENGTH; z++) {
+		for(int x = 0; x < CHUNK_WIDTH; x++) {
+			noiseX[z*CHUNK_WIDTH + x] = (float) ( x + (*chunk).pos[0]*CHUNK_WIDTH + randomNoiseOffset ) / NOISE_ZOOM;
+			noiseY[z*CHUNK_WIDTH + x] = (float) ( z + (*chunk).pos[1]*CHUNK_LENGTH + randomNoiseOffset ) / NOISE_ZOOM;
+		}
+	}
+
+	// sample the noise of the whole chunk in one go, so it can be done several columns at a time
+	noise2_batch(noiseX, noiseY, noiseValues, CHUNK_LENGTH*CHUNK_WIDTH);
+
+	for(int z = 0; z < CHUNK_LENGTH; z++) {
+		for(int x = 0; x < CHUNK_WIDTH; x++) {
+
+			int noiseValue = (int)( noiseValues[z*CHUNK_WIDTH + x] * CHUNK_HEIGHT ) + NOISE_HEIGHT_OFFSET;
+
+			// cap noise value to chunk height
+			if(noiseValue >= CHUNK_HEIGHT) {
+				noiseValue = CHUNK_HEIGHT-1;
+			}
+
+			heightmap[z][x] = noiseValue;
+
+		}
+	}
+}
+
+// fills the blocks from fromY up to and including toY of a column of a blockTypes array with a single type
+void fill_column_run(int8_t* blockTypes, int xPos, int zPos, int fromY, int toY, int type) {
+	for(int y = fromY; y <= toY; y++) {
+		blockTypes[get_block_index(xPos, y, zPos)] = type;
+	}
+}
+
+
+// ---
+
+
+// terrain phase, fills in the generator's blocks with the ground of a chunk based on its position, and notes down the spots
+// that trees start from as anchors (only reads the noise and the world seed, so its safe to run on any worker thread)
+void generate_chunk_terrain(struct Chunk* chunk, struct ChunkGenerator* generator) {
+
+	int8_t* blockTypes = (*generator).blockTypes;
+
+	// the chunk's position, which (along with the world seed) is all its random numbers depend on
+	int chunkX = (*chunk).pos[0];
+	int chunkZ = (*chunk).pos[1];
+
+	// the noise only depends on the column, so its worked out once per column instead of once per block
+	int heightmap[CHUNK_LENGTH][CHUNK_WIDTH];
+	calc_chunk_heightmap(chunk, heightmap);
+
+	// everything starts off as air, the columns are then filled in from the bottom as runs of a single type
+	memset(blockTypes, 0, CHUNK_VOLUME);
+
+	(*generator).anchorCount = 0;
+
+	// stone only appears this high up (coming from top)
+	const int stoneStart = CHUNK_HEIGHT-STONE_LEVEL+1;
+
+	for(int z = 0; z < CHUNK_LENGTH; z++) {
+		for(int x = 0; x < CHUNK_WIDTH; x++) {
+
+			int height = heightmap[z][x];
+
+			// sand up to the sand level
+			fill_column_run(blockTypes, x, z, 1, glm_imin(height, SAND_LEVEL), 4);
+
+			// then dirt up to the stone, with grass on top if the top block is in between
+			fill_column_run(blockTypes, x, z, SAND_LEVEL+1, glm_imin(height, stoneStart-1), 2);
+
+			if(height > SAND_LEVEL && height < stoneStart) {
+				blockTypes[get_block_index(x, height, z)] = 1; // grass
+			}
+
+			// then stone
+			fill_column_run(blockTypes, x, z, stoneStart, height, 3);
+
+			// if bottom most layer, then fill it in automatically
+			blockTypes[get_block_index(x, 0, z)] = 4; // sand
+
+
+			// ---
+
+
+			// tree anchors, right on top of the grass (trees on the sides of the chunk spill over into the chunks next to it)
+			int treeY = height+1;
+
+			if(treeY < CHUNK_HEIGHT-STONE_LEVEL-TREE_BUFFER_LEVEL && treeY > SAND_LEVEL+1) {
+
+				// random value in between 0-1, determines if a tree will be placed (one per column of the chunk)
+				float randomValue = get_chunk_random_float(chunkX, chunkZ, RANDOM_TREE_PLACEMENT, z*CHUNK_WIDTH + x);
+
+				// if value is less than the chance to spawn a tree
+				if(randomValue < CHANCE_OF_TREE) {
+					blockTypes[get_block_index(x, treeY, z)] = 5; // first log block, the rest of the tree is grown from it when decorating
+
+					(*generator).anchors[(*generator).anchorCount++] = (struct FeatureAnchor){ x, treeY, z };
+				}
+			}
+
+		}
+	}
+
+}
+
+
+// ---
+
+
+// places a block that a feature of a chunk is made of, blocks outside of the chunk go into outgoing (or are dropped if its NULL)
+void place_feature_block(struct Chunk* chunk, struct ChunkGenerator* generator, struct BlockWrites* outgoing, int xPos, int yPos, int zPos, int type) {
+
+	// nothing above or below the world
+	if(yPos < 0 || yPos >= CHUNK_HEIGHT) {
+		return;
+	}
+
+	if(xPos >= 0 && xPos < CHUNK_WIDTH && zPos >= 0 && zPos < CHUNK_LENGTH) {
+		(*generator).blockTypes[get_block_index(xPos, yPos, zPos)] = type;
+		return;
+	}
+
+	if(outgoing == NULL) {
+		return;
+	}
+
+	// which chunk over it lands in (features are never more than a chunk wide)
+	int offsetX = xPos < 0 ? -1 : (xPos >= CHUNK_WIDTH ? 1 : 0);
+	int offsetZ = zPos < 0 ? -1 : (zPos >= CHUNK_LENGTH ? 1 : 0);
+
+	add_block_write(outgoing, (struct BlockWrite){
+		.sourceX = (*chunk).pos[0],
+		.sourceZ = (*chunk).pos[1],
+
+		.chunkX = (*chunk).pos[0] + offsetX,
+		.chunkZ = (*chunk).pos[1] + offsetZ,
+
+		.x = xPos - offsetX*CHUNK_WIDTH,
+		.y = yPos,
+		.z = zPos - offsetZ*CHUNK_LENGTH,
+
+		.type = type
+	});
+
+}
+
+// decoration phase, grows a tree from every anchor the terrain phase left, the blocks that end up in surrounding chunks
+// are appended to outgoing instead (reads nothing but the generator and the world seed, so its safe to run on any worker thread)
+void decorate_chunk(struct Chunk* chunk, struct ChunkGenerator* generator, struct BlockWrites* outgoing) {
+
+	int8_t* blockTypes = (*generator).blockTypes;
+
+	int chunkX = (*chunk).pos[0];
+	int chunkZ = (*chunk).pos[1];
+
+	for(int i = 0; i < (*generator).anchorCount; i++) {
+
+		int xPos = (*generator).anchors[i].x;
+		int yPos = (*generator).anchors[i].y;
+		int zPos = (*generator).anchors[i].z;
+
+		// the first log block got covered up by the leaves of an earlier tree
+		if(blockTypes[get_block_index(xPos, yPos, zPos)] != 5) {
+			continue;
+		}
+
+		// the random numbers that make up the shape of this tree, starting at the ones set aside for its column
+		uint32_t treeRandom = (zPos*CHUNK_WIDTH + xPos) * TREE_RANDOM_COUNT;
+
+		// get amount of log blocks to expand upon for blocks (remove 1 cus we already start with one)
+		int logAmount = get_chunk_random_float(chunkX, chunkZ, RANDOM_TREE_SHAPE, treeRandom++) * (MAX_TREE_HEIGHT-MIN_TREE_HEIGHT) + MIN_TREE_HEIGHT - 1;
+
+		// if indexed y position is below half of the stone level (trying to prevent segfaults by indexing out of blockTypes)
+		if(yPos+logAmount > CHUNK_HEIGHT-STONE_LEVEL) {
+			// cap logAmount at that value
+			logAmount = CHUNK_HEIGHT-STONE_LEVEL - yPos;
+		}
+
+		// iterate thru log amount
+		for(int l=0; l < logAmount; l++) {
+			// set that indexed block to a log block
+			blockTypes[get_block_index(xPos, yPos+l, zPos)] = 5;
+		}
+
+
+		// ---
+
+
+		// now leaves blocks
+
+		// top (100% spawn)
+		place_feature_block(chunk, generator, outgoing, xPos, yPos+logAmount, zPos, 6);
+
+		// left (100% spawn)
+		place_feature_block(chunk, generator, outgoing, xPos-1, yPos+logAmount-1, zPos, 6);
+
+		// right (100% spawn)
+		place_feature_block(chunk, generator, outgoing, xPos+1, yPos+logAmount-1, zPos, 6);
+
+		// back (100% spawn)
+		place_feature_block(chunk, generator, outgoing, xPos, yPos+logAmount-1, zPos-1, 6);
+
+		// front (100% spawn)
+		place_feature_block(chunk, generator, outgoing, xPos, yPos+logAmount-1, zPos+1, 6);
+
+		// random amount of extra blocks (12 extra spots if u count it)
+		int extraLeaves = (int)( get_chunk_random_float(chunkX, chunkZ, RANDOM_TREE_SHAPE, treeRandom++) * 12 );
+
+		for(int l=0; l < extraLeaves; l++) {
+			// x can be from -1 - 1
+			int x =  floor( get_chunk_random_float(chunkX, chunkZ, RANDOM_TREE_SHAPE, treeRandom++) * 3  - 1);
+
+			// y can be either 0 or 1
+			int y =  floor( get_chunk_random_float(chunkX, chunkZ, RANDOM_TREE_SHAPE, treeRandom++) * 2 );
+
+			// z can be from -1 - 1
+			int z =  floor( get_chunk_random_float(chunkX, chunkZ, RANDOM_TREE_SHAPE, treeRandom++) * 3  - 1);
+
+			// insert this new leaves block
+			place_feature_block(chunk, generator, outgoing, xPos+x, yPos+logAmount-1+y, zPos+z, 6);
+		}
+
+	}
+
+}
+
+
+// ---
+
+
+// fills the blocks of a chunk with terrain and trees based on its position (doesn't touch opengl, so its safe to call from worker threads),
+// the parts of trees that spill over into surrounding chunks are left out
+void generate_chunk_blocks(struct Chunk* chunk) {
+
+	struct ChunkGenerator generator;
+
+	generate_chunk_terrain(chunk, &generator);
+	decorate_chunk(chunk, &generator, NULL);
+
+	// pack the blocks into the chunk's sections (the ones of all air or all stone end up taking no memory)
+	pack_chunk_blocks(chunk, generator.blockTypes);
+
+}
@@ -0,0 +1,301 @@
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "headers/workers.h"
+
+
+// ---
+
+
+// settings
+
+// amount of jobs the queues are sized for upon the first allocation
+const int WORKER_INITIAL_QUEUE_SIZE = 256;
+
+// most worker threads that will ever be started
+#define MAX_WORKERS 64
+
+
+// ---
+
+
+// a single queued job
+struct WorkerJob {
+	WorkerFunction run; // called on a worker thread
+	WorkerFunction finish; // called on the main thread once run is done
+	void* data; // handed to both
+};
+
+// growable circular queue of jobs
+struct JobQueue {
+	struct WorkerJob* jobs;
+	int head; // index of the first job
+	int count; // amount of jobs in the queue
+	int capacity; // amount of jobs allocated
+};
+
+
+// ---
+
+
+// worker threads
+pthread_t workers[MAX_WORKERS];
+int workerCount = 0;
+
+// jobs waiting to be run, and jobs that have been run and are waiting to be finished on the main thread
+struct JobQueue pendingJobs;
+struct JobQueue finishedJobs;
+
+// amount of jobs currently being run by the workers
+int runningJobs = 0;
+
+// whether or not the workers should shut down
+bool stoppingWorkers = false;
+
+// guards everything above
+pthread_mutex_t workersMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// signalled when a job is queued up (or the workers are stopping)
+pthread_cond_t jobQueued = PTHREAD_COND_INITIALIZER;
+
+// signalled when a worker is done running a job
+pthread_cond_t jobRun = PTHREAD_COND_INITIALIZER;
+
+
+// ---
+
+
+// appends a job to the back of a queue, growing it if its full
+void push_job_queue(struct JobQueue* queue, struct WorkerJob job) {
+
+	// grow the queue if its full
+	if((*queue).count == (*queue).capacity) {
+
+		int newCapacity = (*queue).capacity == 0 ? WORKER_INITIAL_QUEUE_SIZE : (*queue).capacity * 2;
+
+		struct WorkerJob* newJobs = malloc(sizeof(struct WorkerJob) * newCapacity);
+
+		// copy the jobs over in order, unwrapping them
+		for(int i = 0; i < (*queue).count; i++) {
+			newJobs[i] = (*queue).jobs[((*queue).head + i) % (*queue).capacity];
+		}
+
+		free((*queue).jobs);
+
+		(*queue).jobs = newJobs;
+		(*queue).head = 0;
+		(*queue).capacity = newCapacity;
+
+	}
+
+	(*queue).jobs[((*queue).head + (*queue).count) % (*queue).capacity] = job;
+	(*queue).count++;
+
+}
+
+// removes and returns the job at the front of a queue (the queue must not be empty)
+struct WorkerJob pop_job_queue(struct JobQueue* queue) {
+
+	struct WorkerJob job = (*queue).jobs[(*queue).head];
+
+	(*queue).head = ((*queue).head + 1) % (*queue).capacity;
+	(*queue).count--;
+
+	return job;
+
+}
+
+
+// ---
+
+
+// loop that every worker thread runs, taking jobs off the queue until told to stop
+void* worker_loop(void* arg) {
+
+	// workers all share the same job queue, they aren't handed anything of their own
+	(void)arg;
+
+	pthread_mutex_lock(&workersMutex);
+
+	while(true) {
+
+		// sleep until theres something to do
+		while(pendingJobs.count == 0 && !stoppingWorkers) {
+			pthread_cond_wait(&jobQueued, &workersMutex);
+		}
+
+		if(stoppingWorkers) {
+			break;
+		}
+
+		// take the next job
+		struct WorkerJob job = pop_job_queue(&pendingJobs);
+		runningJobs++;
+
+		// run it without holding the lock
+		pthread_mutex_unlock(&workersMutex);
+
+		(*job.run)(job.data);
+
+		pthread_mutex_lock(&workersMutex);
+
+		// hand it over to the main thread
+		push_job_queue(&finishedJobs, job);
+		runningJobs--;
+
+		pthread_cond_broadcast(&jobRun);
+
+	}
+
+	pthread_mutex_unlock(&workersMutex);
+
+	return NULL;
+
+}
+
+
+// ---
+
+
+// starts up the worker threads
+void init_workers() {
+
+	// one worker per core, minus the main thread (but always at least one)
+	long cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+	workerCount = cores > 1 ? cores - 1 : 1;
+
+	if(workerCount > MAX_WORKERS) {
+		workerCount = MAX_WORKERS;
+	}
+
+	stoppingWorkers = false;
+
+	for(int i = 0; i < workerCount; i++) {
+		pthread_create(&workers[i], NULL, worker_loop, NULL);
+	}
+
+}
+
+// getter for the amount of worker threads
+int get_worker_count() {
+	return workerCount;
+}
+
+
+// ---
+
+
+// queues up a job to be run on a worker thread, and then finished on the main thread
+void submit_worker_job(WorkerFunction run, WorkerFunction finish, void* data) {
+
+	pthread_mutex_lock(&workersMutex);
+
+	push_job_queue(&pendingJobs, (struct WorkerJob){ run, finish, data });
+
+	pthread_cond_signal(&jobQueued);
+
+	pthread_mutex_unlock(&workersMutex);
+
+}
+
+
+// ---
+
+
+// finishes up to maxJobs of the jobs that the workers are done with, on the calling (main) thread
+int finish_worker_jobs(int maxJobs) {
+
+	int finished = 0;
+
+	pthread_mutex_lock(&workersMutex);
+
+	while(finished < maxJobs && finishedJobs.count > 0) {
+
+		struct WorkerJob job = pop_job_queue(&finishedJobs);
+
+		// finish without holding the lock, so the workers can keep going
+		pthread_mutex_unlock(&workersMutex);
+
+		if(job.finish != NULL) {
+			(*job.finish)(job.data);
+		}
+
+		finished++;
+
+		pthread_mutex_lock(&workersMutex);
+
+	}
+
+	pthread_mutex_unlock(&workersMutex);
+
+	return finished;
+
+}
+
+// blocks until every submitted job has been run and finished, finishing them as they come in
+void wait_for_worker_jobs() {
+
+	pthread_mutex_lock(&workersMutex);
+
+	while(pendingJobs.count > 0 || runningJobs > 0 || finishedJobs.count > 0) {
+
+		// finish whatever is ready
+		while(finishedJobs.count > 0) {
+
+			struct WorkerJob job = pop_job_queue(&finishedJobs);
+
+			pthread_mutex_unlock(&workersMutex);
+
+			if(job.finish != NULL) {
+				(*job.finish)(job.data);
+			}
+
+			pthread_mutex_lock(&workersMutex);
+
+		}
+
+		// then sleep until another job is done
+		if(pendingJobs.count > 0 || runningJobs > 0) {
+			pthread_cond_wait(&jobRun, &workersMutex);
+		}
+
+	}
+
+	pthread_mutex_unlock(&workersMutex);
+
+}
+
+
+// ---
+
+
+// stops and joins the worker threads
+void terminate_workers() {
+
+	// tell the workers to stop and wake them all up
+	pthread_mutex_lock(&workersMutex);
+
+	stoppingWorkers = true;
+
+	pthread_cond_broadcast(&jobQueued);
+
+	pthread_mutex_unlock(&workersMutex);
+
+	for(int i = 0; i < workerCount; i++) {
+		pthread_join(workers[i], NULL);
+	}
+
+	workerCount = 0;
+
+	// free the queues
+	free(pendingJobs.jobs);
+	free(finishedJobs.jobs);
+
+	pendingJobs = (struct JobQueue){ NULL, 0, 0, 0 };
+	finishedJobs = (struct JobQueue){ NULL, 0, 0, 0 };
+
+}
@@ -5,6 +5,7 @@
 #include <NOISE/noise1234.h>
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "headers/image.h"
@@ -15,7 +16,18 @@
 
 #include "headers/pointer.h"
 #include "headers/chunk.h"
+#include "headers/chunk_loader.h"
+#include "headers/blocks.h"
+#include "headers/block_writes.h"
+#include "headers/terrain.h"
+#include "headers/world_random.h"
+#include "headers/mesher.h"
+#include "headers/mesh_builder.h"
+#include "headers/mesh_arena.h"
+#include "headers/workers.h"
 #include "headers/sky.h"
+#include "headers/culling.h"
+#include "headers/occlusion.h"
 
 
 // ---
@@ -28,6 +40,29 @@ bool wireframeMode = false;
 const int RENDER_DISTANCE = 3;
 const int WORLD_SIZE = 10;
 
+// whether the world streams in around the camera endlessly, instead of being a fixed WORLD_SIZE x WORLD_SIZE grid
+bool streamingWorld = true;
+
+// how many chunks are kept loaded in every direction around the camera when streaming
+// (one more than the render distance, so every drawn chunk has all its surrounding chunks to mesh against)
+const int STREAM_DISTANCE = RENDER_DISTANCE+1;
+
+// most finished chunk jobs (mesh uploads) handled per frame, so streaming doesn't cause frame spikes
+const int MAX_CHUNK_UPLOADS_PER_FRAME = 4;
+
+// seed the world is generated from, the same seed always gives the same world (0 picks a random one every time)
+const unsigned int WORLD_SEED = 0;
+
+// whether or not to skip chunks that can't be seen thru the chunks in between (behind hills, or around the corner in caves)
+bool caveCulling = true;
+
+// whether or not to skip chunks that are hidden behind the solid ground and rock of the chunks in front of them
+bool occlusionCulling = true;
+
+// how many frames old the occlusion buffer is allowed to be before it stops being used
+// (its drawn on a worker while the frame after it is drawn, so its normally one frame old, but it can get stuck behind chunk jobs)
+const int MAX_OCCLUSION_LATENCY = 2;
+
 // keep track of last chunk position of player
 vec2 lastChunkPos = GLM_VEC2_ZERO;
 
@@ -40,21 +75,61 @@ unsigned int worldAtlas;
 // shader program for blocks
 unsigned int blockShaderProgram;
 
+// shader program for blocks meshed into face records (vertex pulling)
+unsigned int blockPullShaderProgram;
 
-// ---
 
+// ---
 
-// array of chunks with land blocks
-struct Chunk* chunks;
 
 // array of chunks with water blocks
 struct Chunk waterChunk;
 
-int chunkCount = 0;
-
 // array that holds the indexes of chunks in the order that they should be drawn
 int* chunksDrawOrder;
 
+// the indexes of chunksDrawOrder that are inside the view frustum, worked out every frame
+int* chunksVisible;
+
+// per chunk index, whether or not its inside the view frustum, and whether or not it can be seen thru the chunks in between
+bool* chunksInView;
+bool* chunksUncovered;
+
+// percentage of the chunks inside the view frustum that cave culling skipped last frame
+float caveCulledPercentage = 0.0f;
+
+
+// ---
+
+
+// an occlusion buffer to be drawn on a worker, out of a snapshot of the occluders of the chunks in view
+struct OcclusionJob {
+	struct OccluderChunk* chunks;
+	int count;
+
+	mat4 viewProj;
+	vec3 camPos;
+
+	int frame; // frame it was snapshotted on
+};
+
+// two occlusion buffers, one that the chunks are tested against while the other is being drawn by a worker
+struct OcclusionBuffer occlusionBuffers[2];
+int readyOcclusionBuffer = 0;
+
+// frame that the ready occlusion buffer was snapshotted on (-1 if nothing has been drawn into it yet)
+int readyOcclusionFrame = -1;
+
+// the job drawing the other buffer, and whether or not its still out on the workers
+struct OcclusionJob occlusionJob;
+bool occlusionJobBusy = false;
+
+// frames drawn so far
+int frameCount = 0;
+
+// percentage of the chunks left over from cave culling that occlusion culling skipped last frame
+float occlusionCulledPercentage = 0.0f;
+
 
 // ---
 
@@ -66,6 +141,21 @@ bool drawingWater = true;
 // ---
 
 
+// block writes of the edit batch that's open, applied all at once by commit_edits (chunkX and chunkZ are the chunk they go
+// into, the source is the same chunk)
+struct BlockWrites editBatch;
+
+// committed block writes that haven't been placed yet, as the workers were busy with (or reading from) the chunk they go into,
+// they're placed in order as soon as it's free again (see apply_pending_edits)
+struct BlockWrites pendingEdits;
+
+// amount of begin_edits calls that haven't been committed yet (batches can be nested, only the outermost commit applies them)
+int editDepth = 0;
+
+
+// ---
+
+
 // toggles drawing water mode
 void toggle_drawing_water() {
 	drawingWater = !drawingWater;
@@ -75,6 +165,84 @@ void toggle_drawing_water() {
 // ---
 
 
+// toggles cave culling, printing how many chunks it culled last frame
+void toggle_cave_culling() {
+	caveCulling = !caveCulling;
+
+	printf("Cave culling %s (%.1f%% of chunks in view culled last frame)\n", caveCulling ? "on" : "off", caveCulledPercentage);
+}
+
+// getter for the percentage of the chunks inside the view frustum that cave culling skipped last frame
+float get_cave_culled_percentage() {
+	return caveCulledPercentage;
+}
+
+
+// toggles occlusion culling, printing how many chunks it culled last frame
+void toggle_occlusion_culling() {
+	occlusionCulling = !occlusionCulling;
+
+	printf("Occlusion culling %s (%.1f%% of chunks culled last frame)\n", occlusionCulling ? "on" : "off", occlusionCulledPercentage);
+}
+
+// getter for the percentage of the chunks left over from cave culling that occlusion culling skipped last frame
+float get_occlusion_culled_percentage() {
+	return occlusionCulledPercentage;
+}
+
+
+// ---
+
+
+// draws the occlusion buffer that isn't being tested against (worker thread)
+void draw_occlusion_job(void* data) {
+	struct OcclusionJob* job = data;
+
+	draw_occlusion_buffer(&occlusionBuffers[1 - readyOcclusionBuffer], (*job).viewProj, (*job).camPos, (*job).chunks, (*job).count);
+}
+
+// swaps the freshly drawn occlusion buffer in for the chunks to be tested against (main thread)
+void finish_occlusion_job(void* data) {
+	struct OcclusionJob* job = data;
+
+	readyOcclusionBuffer = 1 - readyOcclusionBuffer;
+	readyOcclusionFrame = (*job).frame;
+
+	occlusionJobBusy = false;
+}
+
+// snapshots the occluders of count chunks (indices into chunks) and sends them off to be drawn into the occlusion buffer
+// that isn't being tested against, unless its still being drawn
+void submit_occlusion_job(struct Chunk* chunks, int* indices, int count, mat4 viewProj, vec3 camPos) {
+	if(occlusionJobBusy) {
+		return;
+	}
+
+	occlusionJob.count = 0;
+
+	for(int i = 0; i < count; i++) {
+		struct Chunk* chunk = &chunks[indices[i]];
+
+		// the occluders of chunks that are being worked on could be getting written to
+		if(is_chunk_ready(chunk)) {
+			occlusionJob.chunks[occlusionJob.count++] = (struct OccluderChunk){ (*chunk).pos[0], (*chunk).pos[1], (*chunk).occluders };
+		}
+	}
+
+	glm_mat4_copy(viewProj, occlusionJob.viewProj);
+	glm_vec3_copy(camPos, occlusionJob.camPos);
+
+	occlusionJob.frame = frameCount;
+
+	occlusionJobBusy = true;
+
+	submit_worker_job(draw_occlusion_job, finish_occlusion_job, &occlusionJob);
+}
+
+
+// ---
+
+
 // getter for world size
 int get_world_size() {
 	return WORLD_SIZE;
@@ -93,128 +261,178 @@ unsigned int get_world_atlas() {
 // ---
 
 
-// sorts a chunks array based on distance from camera, back to front
+// sorts the chunks based on distance from camera, nearest first (only needs doing when the camera changes chunk)
 void sortChunks() {
-	// create new vec2 array, x for chunk index, y for distance from player
-	vec2 chunksData[WORLD_SIZE*WORLD_SIZE];
-
-
-	// ---
-	
+	int chunkCount = get_loaded_chunk_count();
 
 	// get camera position
 	vec3* camPos = get_camera_pos();
 
-	// create vector2 and load camera position but snapped to chunk position
-	vec2 snappedCamPos;
-	glm_vec2_copy((vec2){
+	// snapped to chunk position
+	int snappedCamPos[2] = {
 		round( (*camPos)[0] / get_chunk_width() ),
 		round( (*camPos)[2] / get_chunk_length() )
-	}, snappedCamPos);
+	};
+
+	// the chunks that are going to be in each slot, the slots switch over to them a few frames after the camera changes chunk,
+	// so their current positions could still be the old ones
+	int positions[chunkCount][2];
+
+	for(int i = 0; i < chunkCount; i++) {
+		get_slot_chunk_pos(i, &positions[i][0], &positions[i][1]);
+	}
+
+	sort_chunks_by_distance(positions, chunkCount, snappedCamPos[0], snappedCamPos[1], chunksDrawOrder);
+}
 
-	// iterate and store array vector2s of index and distance from player into chunksData
-	for(int i=0; i < WORLD_SIZE*WORLD_SIZE; i++) {
-	
-		// get distance of chunk from camera (pythagoras theorem)
-		float dist = sqrt( 
-				snappedCamPos[0] - chunks[i].pos[0]
-				+
-				snappedCamPos[1] - chunks[i].pos[1]
-		);
 
-		// load index and distance into correspondingly indexed vector
-		glm_vec2_copy((vec2){i, dist}, chunksData[i]);
+// ---
+
 
+// rebuilds the dirty sections of every chunk that has any (chunks the workers are busy with get to it once they're done)
+void remesh_dirty_chunks() {
+	// get the loaded chunks
+	struct Chunk* chunks = get_loaded_chunks();
+	int chunkCount = get_loaded_chunk_count();
+
+	for(int i = 0; i < chunkCount; i++) {
+		if((chunks[i].dirtySections != 0 || chunks[i].cullingDirty) && is_chunk_ready(&chunks[i])) {
+			remesh_dirty_sections(&chunks[i], i);
+		}
 	}
+}
 
-	// now actually sort the vectors from lowest to highest distance
-	
-	// boolean to recognize when bubble sort has fully completed
-	bool sorted = false;
+// places every committed block write whose chunk the workers aren't using, in the order they were set, the rest stay pending
+// until a later frame (writes outside of the world or its height are dropped), returns the amount of blocks that changed
+int apply_pending_edits() {
 
-	// amount of swaps per iteration
-	int swaps = 0;
+	int changed = 0;
 
-	// while unsorted
-	while(!sorted) {
+	// amount of writes kept for later, moved down to the start of the list
+	int kept = 0;
 
-		// reset swaps to 0
-		swaps = 0;
+	for(int i = 0; i < pendingEdits.count; i++) {
+		struct BlockWrite write = pendingEdits.writes[i];
 
-		// iterate thru chunksData array
-		for(int i=0; i < WORLD_SIZE*WORLD_SIZE; i++) {
-		
-			// if not the last element
-			if(i != WORLD_SIZE*WORLD_SIZE-1) {
-				
-				// get and store copies of first and second vectors
-				vec2 firstVec;
-				glm_vec2_copy(chunksData[i], firstVec);
-				vec2 secondVec;
-				glm_vec2_copy(chunksData[i+1], secondVec); // next one
-				
-				// if chunk in front has lower distance value
-				if(firstVec[1] > secondVec[1]) {
-
-					// swap the vectors in position within the chunksData array
-					glm_vec2_copy(firstVec, chunksData[i+1]);
-					glm_vec2_copy(secondVec, chunksData[i]);
-
-					// increment swaps
-					swaps++;
-
-				}
+		// get the chunk it goes into
+		struct Chunk* chunk = get_chunk(write.chunkX, write.chunkZ);
 
-			}
+		// if outside of the world or out of y bounds (ABOVE OR BELOW CHUNK) then there's nothing to edit
+		if(chunk == NULL || write.y < 0 || write.y >= get_chunk_height()) {
+			continue;
+		}
 
+		// the workers are using its blocks, so try again later (every later write into it waits as well, as its still in
+		// use for the rest of this loop)
+		if(is_chunk_in_use(chunk)) {
+			pendingEdits.writes[kept++] = write;
+			continue;
 		}
 
-		// if no swaps were made then array is sorted
-		if(swaps == 0) {
-			sorted = true;
+		// a block that's already there doesn't need its sections rebuilding
+		if(get_block_type(chunk, write.x, write.y, write.z) == write.type) {
+			continue;
 		}
 
+		// only marks the sections it affects as dirty, so a section written to any amount of times is rebuilt once
+		insert_block(chunk, (vec4){ write.x, write.y, write.z, write.type });
+
+		changed++;
 	}
 
-	// now fill newChunks array with chunks from inputChunks, but in backwards order based on chunksData
-	
-	// iterate thru chunksData
-	for(int i=0; i < WORLD_SIZE*WORLD_SIZE; i++) {
+	pendingEdits.count = kept;
+
+	return changed;
 
-		// set index of chunksDrawOrder integer
-		chunksDrawOrder[i] = chunksData[i][0];
+}
 
+// opens an edit batch, the blocks set until it's committed are all applied at once
+void begin_edits() {
+	editDepth++;
+}
+
+// closes the open edit batch, if its the outermost one every write in it is placed into block storage, in the order they
+// were set, and then every chunk they touched is remeshed and uploaded once, returns the amount of blocks that changed
+// (writes into chunks the workers are busy with are placed on a later frame, and aren't counted)
+int commit_edits() {
+
+	// nothing to commit
+	if(editDepth == 0) {
+		return 0;
 	}
 
+	editDepth--;
+
+	// the outermost batch applies the writes of the ones inside it as well
+	if(editDepth > 0) {
+		return 0;
+	}
+
+	// the batch goes after whatever is still waiting to be placed, so writes into the same block keep their order
+	for(int i = 0; i < editBatch.count; i++) {
+		add_block_write(&pendingEdits, editBatch.writes[i]);
+	}
+
+	clear_block_writes(&editBatch);
+
+	int changed = apply_pending_edits();
+
+	// rebuild and upload every dirty section of the touched chunks (and their neighbours along the borders) right away,
+	// so the edits show up in the same frame
+	remesh_dirty_chunks();
+
+	return changed;
+
 }
 
+// records a block of the given type at a world block position in the open edit batch (a write outside of a batch is
+// committed straight away as a batch of its own)
+void set_block_world(int xPos, int yPos, int zPos, int type) {
 
-// ---
+	bool ownBatch = editDepth == 0;
 
+	if(ownBatch) {
+		begin_edits();
+	}
 
-// gets a chunk based on the snapped chunks position
-struct Chunk* get_chunk(int xPos, int yPos) {
-	for(int i=0; i < WORLD_SIZE*WORLD_SIZE; i++) {
-		if(chunks[i].pos[0] == xPos && chunks[i].pos[1] == yPos) {
-			return &(chunks[i]);
-		}
+	// position of the chunk the block is in
+	int chunkX = floor( (double)xPos / get_chunk_width() );
+	int chunkZ = floor( (double)zPos / get_chunk_length() );
+
+	add_block_write(&editBatch, (struct BlockWrite){
+		chunkX, chunkZ,
+		chunkX, chunkZ,
+		xPos - chunkX*get_chunk_width(), yPos, zPos - chunkZ*get_chunk_length(),
+		type
+	});
+
+	if(ownBatch) {
+		commit_edits();
 	}
-	return NULL; // by default return NULL
+
 }
 
-// gets the index of a chunk based on the snapped chunks position
-int get_chunk_index(int xPos, int yPos) {
-	for(int i=0; i < WORLD_SIZE*WORLD_SIZE; i++) {
-		if(chunks[i].pos[0] == xPos && chunks[i].pos[1] == yPos) {
-			return i;
+// rebuilds the meshes of all chunks in the world (used after changing how chunks are meshed)
+void remesh_world() {
+	// get the loaded chunks
+	struct Chunk* chunks = get_loaded_chunks();
+	int chunkCount = get_loaded_chunk_count();
+
+	// amount of faces across all chunks
+	int faces = 0;
+
+	for(int i = 0; i < chunkCount; i++) {
+		// chunks still being loaded in get meshed the new way once they're done anyway
+		if(is_chunk_ready(&chunks[i])) {
+			handle_chunk_sides(&chunks[i], i);
 		}
+
+		faces += chunks[i].indexCount / 6;
 	}
-	return 0; // by default return first chunk
-}
 
-// sets an indexed chunk to an inserted chunk object
-void set_chunk(int index, struct Chunk* chunk) {
-	chunks[index] = *chunk;
+	// print out the face count, so different ways of meshing can be compared
+	printf("Rebuilt world meshes: %d faces (greedy meshing %s, vertex pulling %s)\n", faces,
+		get_greedy_meshing() ? "on" : "off", get_vertex_pulling() ? "on" : "off");
 }
 
 
@@ -224,6 +442,14 @@ void set_chunk(int index, struct Chunk* chunk) {
 void init_world() {
 	// create shaderprogram
 	blockShaderProgram = create_shader_program("shaders/block_shader.vert", "shaders/block_shader.frag");
+	blockPullShaderProgram = create_shader_program("shaders/block_pull_shader.vert", "shaders/block_shader.frag");
+
+	// nothing is allocated for edit batches until the first block is set
+	init_block_writes(&editBatch);
+	init_block_writes(&pendingEdits);
+
+	// the texture of every block side only has to be given to the vertex pulling shader once
+	init_pull_shader(blockPullShaderProgram);
 
 	// create texture atlas object
 	worldAtlas = load_texture("assets/atlas.png");
@@ -234,169 +460,59 @@ void init_world() {
 	// initiate sky related stuff
 	init_sky();
 
-	// randomize noise offset for chunk generation
-	randomize_noise_offset();
-
-	// allocate size to chunks
-	chunks = calloc(WORLD_SIZE*WORLD_SIZE, sizeof(struct Chunk));
+	// start up the worker threads that generate and mesh chunks
+	init_workers();
 
-	// allocate for chunksDrawOrder
-	chunksDrawOrder = calloc(WORLD_SIZE*WORLD_SIZE, sizeof(int));
+	// set up the buffers that every chunk mesh is uploaded into
+	init_mesh_arena();
 
-	// coordinates for drawing chunks (from a 2D top-down perspective)
-	int xPos = 0;
-	int yPos = 0;
+	// seed the world generation (everything random about a chunk comes from this seed and the chunk's position)
+	set_world_seed(WORLD_SEED != 0 ? WORLD_SEED : (unsigned int)rand());
 
-	// generate water chunk
-	waterChunk  = generate_chunk((vec2){0, 0}, WORLD_SIZE, true);
-
-	// iterate thru x and z based on render distance
-	for(int i = 0; i < WORLD_SIZE*WORLD_SIZE; i++) {
-		// generate indexed chunk
-		chunks[chunkCount] = generate_chunk((vec2){xPos, yPos}, WORLD_SIZE, false);
-
-		// increment chunk count
-		chunkCount++;
-
-
-		// ---
+	// centre the camera in the middle of world
+	centre_cam_pos(WORLD_SIZE, get_chunk_width(), get_chunk_length());
 
+	// the chunks buffer either holds the whole world, or just the chunks around the camera when streaming
+	int ringSize = streamingWorld ? 2*STREAM_DISTANCE+1 : WORLD_SIZE;
 
-		// handle incrementing xPos and yPos
-		xPos++;
-		if(xPos >= WORLD_SIZE) {
-			xPos = 0;
-			yPos++;
-		}
+	// every loaded chunk needs a slot for its offset in the block shaders, chunks past the last slot would be drawn in the
+	// wrong place, so give up rather than carry on (lower RENDER_DISTANCE or WORLD_SIZE, or raise MAX_CHUNK_SLOTS along with
+	// the chunkOffsets arrays of the shaders)
+	if(ringSize*ringSize > MAX_CHUNK_SLOTS) {
+		printf("Too many chunks loaded (%d) for the block shader, which only has %d chunk slots\n", ringSize*ringSize, MAX_CHUNK_SLOTS);
+		exit(EXIT_FAILURE);
 	}
 
-	// iterate thru the new chunks again
-	for(int i = 0; i < WORLD_SIZE*WORLD_SIZE; i++) {
-
-		// declare necessary chunks for side handling
-		struct Chunk chunk;
-		struct Chunk* leftChunk;
-		struct Chunk* rightChunk;
-		struct Chunk* topChunk;
-		struct Chunk* bottomChunk;
-
-		// if not on the edges
-		if( chunks[i].pos[0] != 0 && chunks[i].pos[0] != WORLD_SIZE-1
-			&& chunks[i].pos[1] != 0 && chunks[i].pos[1] != WORLD_SIZE-1) {
-
-			// get and define main chunk and surrounding chunks
-			chunk       = chunks[i];
-			leftChunk   = get_chunk(chunks[i].pos[0]-1, chunks[i].pos[1]);
-			rightChunk  = get_chunk(chunks[i].pos[0]+1, chunks[i].pos[1]);
-			topChunk    = get_chunk(chunks[i].pos[0],   chunks[i].pos[1]+1);
-			bottomChunk = get_chunk(chunks[i].pos[0],   chunks[i].pos[1]-1);
-		
-			// handle chunk sides for the indexed chunk
-			handle_chunk_sides(&chunk, leftChunk, rightChunk, topChunk, bottomChunk);	
-
-		}
-		// bottom left corner
-		else if(chunks[i].pos[0] == 0 && chunks[i].pos[1] == 0) {
-
-			// get and define main chunk and surrounding chunks
-			chunk       = chunks[i];
-			rightChunk  = get_chunk(chunks[i].pos[0]+1, chunks[i].pos[1]);
-			topChunk    = get_chunk(chunks[i].pos[0],   chunks[i].pos[1]+1);
-		
-			// handle chunk sides for the indexed chunk (pass NULL for nonexistent surrounding chunks)
-			handle_chunk_sides(&chunk, NULL, rightChunk, topChunk, NULL);	
-
-		}
-		// bottom right corner
-		else if(chunks[i].pos[0] == WORLD_SIZE-1 && chunks[i].pos[1] == 0) {
-
-			// get and define main chunk and surrounding chunks
-			chunk       = chunks[i];
-			leftChunk   = get_chunk(chunks[i].pos[0]-1, chunks[i].pos[1]);
-			topChunk    = get_chunk(chunks[i].pos[0],   chunks[i].pos[1]+1);
-		
-			// handle chunk sides for the indexed chunk (pass NULL for nonexistent surrounding chunks)
-			handle_chunk_sides(&chunk, leftChunk, NULL, topChunk, NULL);	
-
-		}
-		// top left corner
-		else if(chunks[i].pos[0] == 0 && chunks[i].pos[1] == WORLD_SIZE-1) {
-
-			// get and define main chunk and surrounding chunks
-			chunk       = chunks[i];
-			rightChunk  = get_chunk(chunks[i].pos[0]+1, chunks[i].pos[1]);
-			bottomChunk = get_chunk(chunks[i].pos[0],   chunks[i].pos[1]-1);
-		
-			// handle chunk sides for the indexed chunk (pass NULL for nonexistent surrounding chunks)
-			handle_chunk_sides(&chunk, NULL, rightChunk, NULL, bottomChunk);	
+	// start streaming around the chunk the camera is in
+	vec3* camPos = get_camera_pos();
 
-		}
-		// top right corner
-		else if(chunks[i].pos[0] == WORLD_SIZE-1 && chunks[i].pos[1] == WORLD_SIZE-1) {
+	glm_vec2_copy((vec2){
+		round( (*camPos)[0] / get_chunk_width() ),
+		round( (*camPos)[2] / get_chunk_length() )
+	}, lastChunkPos);
 
-			// get and define main chunk and surrounding chunks
-			chunk       = chunks[i];
-			leftChunk   = get_chunk(chunks[i].pos[0]-1, chunks[i].pos[1]);
-			bottomChunk = get_chunk(chunks[i].pos[0],   chunks[i].pos[1]-1);
-		
-			// handle chunk sides for the indexed chunk (pass NULL for nonexistent surrounding chunks)
-			handle_chunk_sides(&chunk, leftChunk, NULL, NULL, bottomChunk);	
+	// set up the chunk slots, the meshes the workers build for them get uploaded on the main thread
+	init_chunk_loader(ringSize, streamingWorld, lastChunkPos[0], lastChunkPos[1], upload_chunk_mesh);
 
-		}
-		// left side
-		else if(chunks[i].pos[0] == 0) {
-
-			// get and define main chunk and surrounding chunks
-			chunk       = chunks[i];
-			rightChunk  = get_chunk(chunks[i].pos[0]+1, chunks[i].pos[1]);
-			topChunk    = get_chunk(chunks[i].pos[0],   chunks[i].pos[1]+1);
-			bottomChunk = get_chunk(chunks[i].pos[0],   chunks[i].pos[1]-1);
-		
-			// handle chunk sides for the indexed chunk (pass corresponding nonexistent side chunk as NULL)
-			handle_chunk_sides(&chunk, NULL, rightChunk, topChunk, bottomChunk);	
+	// allocate for chunksDrawOrder
+	chunksDrawOrder = calloc(ringSize*ringSize, sizeof(int));
+	chunksVisible = calloc(ringSize*ringSize, sizeof(int));
+	chunksInView = calloc(ringSize*ringSize, sizeof(bool));
+	chunksUncovered = calloc(ringSize*ringSize, sizeof(bool));
 
-		}
-		// right side
-		else if(chunks[i].pos[0] == WORLD_SIZE-1) {
-
-			// get and define main chunk and surrounding chunks
-			chunk       = chunks[i];
-			leftChunk   = get_chunk(chunks[i].pos[0]-1, chunks[i].pos[1]);
-			topChunk    = get_chunk(chunks[i].pos[0],   chunks[i].pos[1]+1);
-			bottomChunk = get_chunk(chunks[i].pos[0],   chunks[i].pos[1]-1);
-		
-			// handle chunk sides for the indexed chunk (pass corresponding nonexistent side chunk as NULL)
-			handle_chunk_sides(&chunk, leftChunk, NULL, topChunk, bottomChunk);	
+	// the occlusion buffers, and room to snapshot the occluders of every chunk
+	init_occlusion_buffer(&occlusionBuffers[0]);
+	init_occlusion_buffer(&occlusionBuffers[1]);
 
-		}
-		// top side
-		else if(chunks[i].pos[1] == WORLD_SIZE-1) {
-
-			// get and define main chunk and surrounding chunks
-			chunk       = chunks[i];
-			leftChunk   = get_chunk(chunks[i].pos[0]-1, chunks[i].pos[1]);
-			rightChunk  = get_chunk(chunks[i].pos[0]+1, chunks[i].pos[1]);
-			bottomChunk = get_chunk(chunks[i].pos[0],   chunks[i].pos[1]-1);
-		
-			// handle chunk sides for the indexed chunk (pass corresponding nonexistent side chunk as NULL)
-			handle_chunk_sides(&chunk, leftChunk, rightChunk, NULL, bottomChunk);	
+	occlusionJob.chunks = calloc(ringSize*ringSize, sizeof(struct OccluderChunk));
 
-		}
-		// bottom side
-		else if(chunks[i].pos[1] == 0) {
-
-			// get and define main chunk and surrounding chunks
-			chunk       = chunks[i];
-			leftChunk   = get_chunk(chunks[i].pos[0]-1, chunks[i].pos[1]);
-			rightChunk  = get_chunk(chunks[i].pos[0]+1, chunks[i].pos[1]);
-			topChunk    = get_chunk(chunks[i].pos[0],   chunks[i].pos[1]+1);
-		
-			// handle chunk sides for the indexed chunk (pass corresponding nonexistent side chunk as NULL)
-			handle_chunk_sides(&chunk, leftChunk, rightChunk, topChunk, NULL);	
+	// generate water chunk, covering all the loaded chunks
+	waterChunk  = generate_water_chunk((vec2){0, 0}, ringSize);
 
-		}
+	// load in the chunks, then wait for them all to be generated, meshed and uploaded before starting
+	update_chunk_loader(0);
 
-	}
+	wait_for_worker_jobs();
 
 	// initiate test block related stuff
 	init_test_block();
@@ -407,13 +523,6 @@ void init_world() {
 
 	// sort chunk draw order
 	sortChunks();
-
-
-	// ---
-	
-
-	// centre the camera in the middle of world
-	centre_cam_pos(WORLD_SIZE, get_chunk_width(), get_chunk_length());
 }
 
 void update_world(GLFWwindow* window, float deltaTime) {
@@ -429,25 +538,47 @@ void update_world(GLFWwindow* window, float deltaTime) {
 			}, 
 			playerChunkPos);
 
-	// snap chunk positions to world edges
-	if(playerChunkPos[0] <= 0) {
-		playerChunkPos[0] = 0;
-	}
-	if(playerChunkPos[0] >= WORLD_SIZE-1) {
-		playerChunkPos[0] = WORLD_SIZE-1;
-	}
-	if(playerChunkPos[1] <= 0) {
-		playerChunkPos[1] = 0;
-	}
-	if(playerChunkPos[1] >= WORLD_SIZE-1) {
-		playerChunkPos[1] = WORLD_SIZE-1;
+	// snap chunk positions to world edges (a streaming world doesn't have any)
+	if(!streamingWorld) {
+		if(playerChunkPos[0] <= 0) {
+			playerChunkPos[0] = 0;
+		}
+		if(playerChunkPos[0] >= WORLD_SIZE-1) {
+			playerChunkPos[0] = WORLD_SIZE-1;
+		}
+		if(playerChunkPos[1] <= 0) {
+			playerChunkPos[1] = 0;
+		}
+		if(playerChunkPos[1] >= WORLD_SIZE-1) {
+			playerChunkPos[1] = WORLD_SIZE-1;
+		}
 	}
 
 	// if moved to another chunk
 	if(playerChunkPos[0] != lastChunkPos[0] || playerChunkPos[1] != lastChunkPos[1]) {
+
+		// when streaming, the loaded chunks follow the camera
+		set_chunk_loader_centre(playerChunkPos[0], playerChunkPos[1]);
+
 		sortChunks();
 	}
 
+	// swap out the chunks that fell out of range for the ones that came into it, and upload whatever the workers have finished
+	update_chunk_loader(MAX_CHUNK_UPLOADS_PER_FRAME);
+
+	// place the edits that were waiting on the workers to be done with their chunks
+	if(pendingEdits.count > 0) {
+		apply_pending_edits();
+	}
+
+	// rebuild only the sections of chunks that block edits changed since last frame
+	remesh_dirty_chunks();
+
+	// keep the water centred on the loaded chunks
+	if(streamingWorld) {
+		glm_vec2_copy((vec2){playerChunkPos[0] - STREAM_DISTANCE, playerChunkPos[1] - STREAM_DISTANCE}, waterChunk.pos);
+	}
+
 
 	// at end of function, copy over player chunk position to lastChunkPos for next frame
 	glm_vec2_copy(playerChunkPos, lastChunkPos);
@@ -484,22 +615,105 @@ void draw_world(GLFWwindow* window) {
 	// ---
 		
 
-	// iterate thru x and z based on render distance
-	for(int i = 0; i < chunkCount; i++) {
+	// get the loaded chunks
+	struct Chunk* chunks = get_loaded_chunks();
+	int chunkCount = get_loaded_chunk_count();
+
+	// combined camera matrices, to get the view frustum from
+	mat4 viewProj;
+	glm_mat4_mul(*get_projection(), *get_view(), viewProj);
+	glm_mat4_mul(viewProj, *get_model(), viewProj);
+
+	// skip the chunks that are out of view (behind the camera or off to the sides)
+	int visibleCount = cull_chunks_frustum(viewProj, chunks, chunksDrawOrder, chunkCount, chunksVisible);
+
+	// draw the next occlusion buffer on a worker while this frame is being drawn, out of the chunks in view
+	// (before cave culling, which can leave out the ones right in front of the camera that hide the rest)
+	if(occlusionCulling) {
+		submit_occlusion_job(chunks, chunksVisible, visibleCount, viewProj, *camPos);
+	}
+
+	// then the ones that are hidden by the chunks in between
+	if(caveCulling) {
+		memset(chunksInView, 0, sizeof(bool) * chunkCount);
+		memset(chunksUncovered, 0, sizeof(bool) * chunkCount);
+
+		for(int i = 0; i < visibleCount; i++) {
+			chunksInView[chunksVisible[i]] = true;
+		}
 
-		int index = (int)chunksDrawOrder[i];
+		// a streaming world only has chunks within the stream distance, a fixed one could have them all on one side
+		int range = streamingWorld ? STREAM_DISTANCE : WORLD_SIZE;
+
+		cull_chunks_caves(get_chunk, chunks, range,
+			floor( (*camPos)[0] / get_chunk_width() ), floor( (*camPos)[2] / get_chunk_length() ), (*camPos)[1] >= get_chunk_height(),
+			chunksInView, chunksUncovered);
+
+		// keep the order
+		int uncoveredCount = 0;
+
+		for(int i = 0; i < visibleCount; i++) {
+			if(chunksUncovered[chunksVisible[i]]) {
+				chunksVisible[uncoveredCount++] = chunksVisible[i];
+			}
+		}
+
+		caveCulledPercentage = visibleCount > 0 ? 100.0f * (visibleCount - uncoveredCount) / visibleCount : 0.0f;
+
+		visibleCount = uncoveredCount;
+	}
+
+	// then the ones that are hidden behind the ground and rock in front of them, tested against the occlusion buffer
+	// drawn last frame (which is left alone if its gotten too old)
+	if(occlusionCulling && readyOcclusionFrame >= 0 && frameCount - readyOcclusionFrame <= MAX_OCCLUSION_LATENCY) {
+		struct OcclusionBuffer* buffer = &occlusionBuffers[readyOcclusionBuffer];
+
+		// keep the order
+		int unoccludedCount = 0;
+
+		for(int i = 0; i < visibleCount; i++) {
+			struct Chunk* chunk = &chunks[chunksVisible[i]];
+
+			// chunks the workers are busy with are kept, their occluders could be being written to right now
+			if(!is_chunk_ready(chunk)) {
+				chunksVisible[unoccludedCount++] = chunksVisible[i];
+				continue;
+			}
+
+			vec3 boxMin = { (*chunk).pos[0]*CHUNK_WIDTH, 0, (*chunk).pos[1]*CHUNK_LENGTH };
+			vec3 boxMax = { boxMin[0] + CHUNK_WIDTH, (*chunk).occluders.topHeight, boxMin[2] + CHUNK_LENGTH };
+
+			if(!is_box_occluded(buffer, boxMin, boxMax)) {
+				chunksVisible[unoccludedCount++] = chunksVisible[i];
+			}
+		}
+
+		occlusionCulledPercentage = visibleCount > 0 ? 100.0f * (visibleCount - unoccludedCount) / visibleCount : 0.0f;
+
+		visibleCount = unoccludedCount;
+	}
+
+	// keep the chunks within the render distance that have something to draw (in order, nearest first)
+	int drawCount = 0;
+
+	for(int i = 0; i < visibleCount; i++) {
+
+		int index = chunksVisible[i];
 		
-		if((chunks[index].pos[0] < lastChunkPos[0]+RENDER_DISTANCE
+		if(chunks[index].indexCount > 0
+			&& (chunks[index].pos[0] < lastChunkPos[0]+RENDER_DISTANCE
 			&& chunks[index].pos[0] >= lastChunkPos[0]-RENDER_DISTANCE)
 			&& (chunks[index].pos[1] < lastChunkPos[1]+RENDER_DISTANCE
 			&& chunks[index].pos[1] >= lastChunkPos[1]-RENDER_DISTANCE)) {
 
-			draw_chunk(chunks[index], blockShaderProgram, worldAtlas, false, drawingWater);
-
+			chunksVisible[drawCount++] = index;
 
 		}
 	}
 
+	// and draw them all with a single draw call
+	draw_chunks(chunks, chunkCount, chunksVisible, drawCount, blockShaderProgram, blockPullShaderProgram, worldAtlas, drawingWater);
+
 
 	// ---
 
@@ -523,6 +737,8 @@ void draw_world(GLFWwindow* window) {
 	// draw crosshair
 	draw_crosshair(window, worldAtlas);
 
+	frameCount++;
+
 }
 
 
@@ -532,9 +748,25 @@ void draw_world(GLFWwindow* window) {
 // terminates stuff from the world
 void terminate_world() {
 
+	// stop the worker threads
+	terminate_workers();
+
 	// free everything from heap memory
-	free(chunks);
+	terminate_chunk_loader();
 	free(chunksDrawOrder);
+	free(chunksVisible);
+	free(chunksInView);
+	free(chunksUncovered);
+	free_block_writes(&editBatch);
+	free_block_writes(&pendingEdits);
+
+	// the workers are gone, so nothing is drawing into them anymore
+	free_occlusion_buffer(&occlusionBuffers[0]);
+	free_occlusion_buffer(&occlusionBuffers[1]);
+	free(occlusionJob.chunks);
+
+	// and the meshes of the chunks
+	terminate_mesh_arena();
 
 }
 
@@ -0,0 +1,60 @@
+#include <stdint.h>
+
+#include "headers/world_random.h"
+
+// counter based random numbers for world generation, every number is a hash of the world seed, the chunk,
+// what the number is for and a counter, instead of coming from a shared sequence like rand,
+// so chunks come out the same no matter which thread generates them or in what order
+
+
+// ---
+
+
+// the seed the world is generated from
+uint32_t worldSeed = 0;
+
+
+// ---
+
+
+// sets the seed that the whole world is generated from
+void set_world_seed(uint32_t seed) {
+	worldSeed = seed;
+}
+
+// getter for the world seed
+uint32_t get_world_seed() {
+	return worldSeed;
+}
+
+
+// ---
+
+
+// scrambles the bits of a 64 bit value (the splitmix64 finaliser), small changes to the input change about half the output bits
+uint64_t mix_random_bits(uint64_t value) {
+	value ^= value >> 30;
+	value *= 0xbf58476d1ce4e5b9ULL;
+	value ^= value >> 27;
+	value *= 0x94d049bb133111ebULL;
+	value ^= value >> 31;
+
+	return value;
+}
+
+// the counter'th random number for a purpose in a chunk
+uint32_t get_chunk_random(int chunkX, int chunkZ, enum RandomPurpose purpose, uint32_t counter) {
+	// each part of the key is mixed in one after another, so no two keys end up sharing a sequence
+	uint64_t hash = mix_random_bits(worldSeed + 0x9e3779b97f4a7c15ULL);
+
+	hash = mix_random_bits(hash ^ ( (uint64_t)(uint32_t)chunkX << 32 | (uint32_t)chunkZ ));
+	hash = mix_random_bits(hash ^ ( (uint64_t)purpose << 32 | counter ));
+
+	return hash >> 32;
+}
+
+// same as get_chunk_random, but as a float in between 0 (inclusive) and 1 (exclusive)
+float get_chunk_random_float(int chunkX, int chunkZ, enum RandomPurpose purpose, uint32_t counter) {
+	// only 24 bits fit in a float exactly, so it can never round up to 1
+	return (get_chunk_random(chunkX, chunkZ, purpose, counter) >> 8) / 16777216.0f;
+}